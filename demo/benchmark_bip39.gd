@@ -0,0 +1,59 @@
+extends SceneTree
+
+# Measures BIP39 wallet restore time on this device.
+# Run with: godot --headless --path demo -s benchmark_bip39.gd
+#
+# Restore is dominated by the 2048 PBKDF2-HMAC-SHA512 rounds in
+# mnemonic_to_seed, so that is timed on its own, then a full restore
+# (seed, master key, first 20 receive addresses) for comparison.
+
+const RUNS = 20
+const MNEMONIC = "legal winner thank year wave sausage worth useful legal winner thank yellow"
+const EXPECTED_SEED = "878386efb78845b3355bd15ea4d39ef97d179cb712b77d5c12b6be415fffeffe5f377ba02bf3f8544ab800b955e51fbff09828f682052a20faa6addbbddfb096"
+
+func _init():
+	print("=== BIP39 restore benchmark ===")
+	print("Device: ", OS.get_model_name(), " / ", OS.get_name())
+	print("CPU: ", OS.get_processor_name(), " (", OS.get_processor_count(), " threads)")
+
+	var seed = DogeHDWallet.mnemonic_to_seed(MNEMONIC)
+	if seed.hex_encode() != EXPECTED_SEED:
+		push_error("Seed mismatch, got " + seed.hex_encode())
+		quit(1)
+		return
+
+	var seed_times = []
+	for i in RUNS:
+		var start = Time.get_ticks_usec()
+		DogeHDWallet.mnemonic_to_seed(MNEMONIC)
+		seed_times.append((Time.get_ticks_usec() - start) / 1000.0)
+
+	var restore_times = []
+	for i in RUNS:
+		var start = Time.get_ticks_usec()
+		var hd = DogeHDWallet.from_mnemonic(MNEMONIC)
+		hd.derive_range("m/44'/3'/0'/0", 0, 20)
+		restore_times.append((Time.get_ticks_usec() - start) / 1000.0)
+
+	_report("mnemonic_to_seed", seed_times)
+	_report("full restore (20 addresses)", restore_times)
+
+	var median = _median(seed_times)
+	var device_class = "high-end"
+	if median > 50.0:
+		device_class = "low-end"
+	elif median > 15.0:
+		device_class = "mid-range"
+	print("Device class by seed time: ", device_class)
+
+	quit()
+
+func _median(times: Array) -> float:
+	var sorted = times.duplicate()
+	sorted.sort()
+	return sorted[sorted.size() / 2]
+
+func _report(label: String, times: Array):
+	var sorted = times.duplicate()
+	sorted.sort()
+	print("%s: min %.2f ms, median %.2f ms, max %.2f ms" % [label, sorted[0], _median(times), sorted[-1]])
@@ -0,0 +1,16 @@
+#include "binding_utils.h"
+#include "crypto/keypair.h"
+
+#include <godot_cpp/classes/project_settings.hpp>
+
+#include <algorithm>
+
+String reversed_hex(const uint8_t* hash) {
+    uint8_t reversed[32];
+    std::reverse_copy(hash, hash + 32, reversed);
+    return String(doge::bytes_to_hex(reversed, 32).c_str());
+}
+
+std::string os_path(const String& path) {
+    return ProjectSettings::get_singleton()->globalize_path(path).utf8().get_data();
+}
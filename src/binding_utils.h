@@ -0,0 +1,17 @@
+#ifndef DOGE_BINDING_UTILS_H
+#define DOGE_BINDING_UTILS_H
+
+#include <godot_cpp/variant/string.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace godot;
+
+// Display form of a 32-byte hash (txid, block hash): byte-reversed hex
+String reversed_hex(const uint8_t* hash);
+
+// user:// and res:// paths as OS paths for mmap and stdio
+std::string os_path(const String& path);
+
+#endif // DOGE_BINDING_UTILS_H
@@ -12,38 +12,47 @@ std::string public_key_to_address(const std::vector<uint8_t>& public_key,
         return ""; // Invalid public key size
     }
 
-    // Version byte: 0x1e for mainnet, 0x71 for testnet
-    uint8_t version = mainnet ? 0x1e : 0x71;
+    ParsedAddress parsed;
+    parsed.version = mainnet ? ADDRESS_VERSION_MAINNET : ADDRESS_VERSION_TESTNET;
 
     // Calculate hash160 (RIPEMD160(SHA256(public_key)))
-    uint8_t pubkey_hash[20];
-    hash160(public_key.data(), public_key.size(), pubkey_hash);
-
-    // Build payload: version + pubkey_hash
-    std::vector<uint8_t> payload;
-    payload.push_back(version);
-    payload.insert(payload.end(), pubkey_hash, pubkey_hash + 20);
+    hash160(public_key.data(), public_key.size(), parsed.hash);
 
     // Base58Check encode
-    return base58check_encode(payload);
+    return format_address(parsed);
 }
 
-bool validate_address(const std::string& address, bool mainnet) {
-    std::vector<uint8_t> payload;
-    if (!base58check_decode(address, payload)) {
+bool parse_address(const std::string& address, ParsedAddress& out) {
+    // Payload is 21 bytes: 1 version + 20 hash
+    uint8_t payload[21];
+    if (base58check_decode_into(address, payload, sizeof(payload)) != 21) {
         return false;
     }
 
-    // Check payload length (21 bytes: 1 version + 20 hash)
-    if (payload.size() != 21) {
+    if (payload[0] != ADDRESS_VERSION_MAINNET && payload[0] != ADDRESS_VERSION_TESTNET) {
         return false;
     }
 
-    // Check version byte
-    uint8_t version = payload[0];
-    uint8_t expected_version = mainnet ? 0x1e : 0x71;
+    out.version = payload[0];
+    memcpy(out.hash, payload + 1, 20);
+    return true;
+}
+
+std::string format_address(const ParsedAddress& address) {
+    uint8_t payload[21];
+    payload[0] = address.version;
+    memcpy(payload + 1, address.hash, 20);
+    return base58check_encode(payload, sizeof(payload));
+}
 
-    return version == expected_version;
+bool validate_address(const std::string& address, bool mainnet) {
+    ParsedAddress parsed;
+    if (!parse_address(address, parsed)) {
+        return false;
+    }
+
+    // Check version byte
+    return parsed.is_mainnet() == mainnet;
 }
 
 std::string wif_to_address(const std::string& wif) {
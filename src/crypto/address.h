@@ -7,6 +7,26 @@
 
 namespace doge {
 
+// P2PKH version bytes
+const uint8_t ADDRESS_VERSION_MAINNET = 0x1e;
+const uint8_t ADDRESS_VERSION_TESTNET = 0x71;
+
+// A P2PKH address decoded once: version byte + hash160 of the public key.
+// Comparing against a recovered key is then a 20-byte compare.
+struct ParsedAddress {
+    uint8_t version = 0;
+    uint8_t hash[20] = {};
+
+    bool is_mainnet() const { return version == ADDRESS_VERSION_MAINNET; }
+};
+
+// Decode a mainnet or testnet P2PKH address. Fails on a bad checksum,
+// length or version.
+bool parse_address(const std::string& address, ParsedAddress& out);
+
+// Base58Check form of a parsed address
+std::string format_address(const ParsedAddress& address);
+
 // Generate Dogecoin address from public key
 // mainnet: version 0x1e (produces 'D' prefix)
 // testnet: version 0x71 (produces 'n' prefix)
@@ -0,0 +1,342 @@
+#include "address_index.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define DOGE_PREFETCH(p) _mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define DOGE_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define DOGE_PREFETCH(p) ((void)(p))
+#endif
+
+namespace doge {
+
+// File header, also the first 64 bytes of the in-memory buffer. Followed by
+// bloom_blocks * 64 filter bytes, slot_count 4-byte tags and slot_count
+// 20-byte keys.
+struct AddressIndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t slot_count;
+    uint64_t entry_count;
+    uint64_t bloom_blocks;
+    uint8_t reserved[24];
+};
+static_assert(sizeof(AddressIndexHeader) == 64, "index header must stay 64 bytes");
+
+static const char INDEX_MAGIC[8] = {'D', 'O', 'G', 'E', 'A', 'I', 'D', 'X'};
+static const uint32_t INDEX_VERSION = 1;
+static const uint32_t INDEX_BYTE_ORDER = 0x01020304;
+
+static const size_t MIN_SLOTS = 1024;
+static const size_t BLOOM_PROBES = 6;
+static const size_t BATCH_GROUP = 16;
+
+// Keys are hash160 outputs, so their bytes are already uniform: bytes 0-3
+// give the tag, 4-7 the home slot, 8-11 the Bloom block and 12-19 the bit
+// positions inside it, all independent of each other.
+static inline uint32_t load32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint64_t load64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+// Map a uniform 32-bit value onto [0, n) without a division
+static inline size_t reduce(uint32_t x, size_t n) {
+    return static_cast<size_t>((static_cast<uint64_t>(x) * n) >> 32);
+}
+
+// Tags are never 0, which marks an empty slot
+static inline uint32_t tag_of(const uint8_t* hash160) {
+    return load32(hash160) | 1;
+}
+
+// At most 80% full; slot counts stay a multiple of 16 so the key array
+// starts on a cache line
+static size_t slots_for(size_t count) {
+    size_t slots = count + count / 4 + 16;
+    return std::max(MIN_SLOTS, (slots + 15) & ~static_cast<size_t>(15));
+}
+
+static size_t layout_size(size_t slots, size_t bloom_blocks) {
+    return sizeof(AddressIndexHeader) + bloom_blocks * 64 + slots * 24;
+}
+
+AddressIndex::AddressIndex(bool bloom_filter) : bloom_enabled_(bloom_filter) {
+}
+
+void AddressIndex::clear(bool bloom_filter) {
+    file_.close();
+    std::vector<uint8_t>().swap(owned_);
+    bloom_enabled_ = bloom_filter;
+    slots_ = 0;
+    count_ = 0;
+    bloom_blocks_ = 0;
+    base_ = nullptr;
+    bloom_ = nullptr;
+    tags_ = nullptr;
+    keys_ = nullptr;
+}
+
+void AddressIndex::allocate(size_t slots) {
+    // 8 filter bits per slot is ~10 bits per key at full load (~1% false
+    // positives with 6 probes)
+    size_t blocks = bloom_enabled_ ? (slots + 63) / 64 : 0;
+
+    owned_.assign(layout_size(slots, blocks), 0);
+    slots_ = slots;
+    count_ = 0;
+    bloom_blocks_ = blocks;
+
+    base_ = owned_.data();
+    bloom_ = base_ + sizeof(AddressIndexHeader);
+    tags_ = reinterpret_cast<const uint32_t*>(bloom_ + blocks * 64);
+    keys_ = reinterpret_cast<const uint8_t*>(tags_ + slots);
+}
+
+void AddressIndex::rehash(size_t slots) {
+    std::vector<uint8_t> old_buffer;
+    old_buffer.swap(owned_);
+    const uint32_t* old_tags = tags_;
+    const uint8_t* old_keys = keys_;
+    size_t old_slots = slots_;
+
+    allocate(slots);
+    for (size_t i = 0; i < old_slots; i++) {
+        if (old_tags[i] != 0) {
+            place(old_keys + i * 20);
+        }
+    }
+
+    // A mapped source is no longer referenced
+    file_.close();
+}
+
+void AddressIndex::make_writable() {
+    if (!file_.is_open()) {
+        return;
+    }
+    owned_.assign(base_, base_ + byte_size());
+    const uint8_t* old_base = base_;
+    base_ = owned_.data();
+    bloom_ = base_ + (bloom_ - old_base);
+    tags_ = reinterpret_cast<const uint32_t*>(base_ + (reinterpret_cast<const uint8_t*>(tags_) - old_base));
+    keys_ = base_ + (keys_ - old_base);
+    file_.close();
+}
+
+void AddressIndex::reserve(size_t count) {
+    size_t slots = slots_for(count);
+    if (slots > slots_) {
+        rehash(slots);
+    }
+}
+
+void AddressIndex::place(const uint8_t* hash160) {
+    uint32_t* tags = const_cast<uint32_t*>(tags_);
+    uint8_t* keys = const_cast<uint8_t*>(keys_);
+
+    size_t i = reduce(load32(hash160 + 4), slots_);
+    while (tags[i] != 0) {
+        if (++i == slots_) {
+            i = 0;
+        }
+    }
+    tags[i] = tag_of(hash160);
+    memcpy(keys + i * 20, hash160, 20);
+
+    if (bloom_blocks_) {
+        uint8_t* block = const_cast<uint8_t*>(bloom_) + reduce(load32(hash160 + 8), bloom_blocks_) * 64;
+        uint64_t bits = load64(hash160 + 12);
+        for (size_t k = 0; k < BLOOM_PROBES; k++) {
+            uint32_t bit = static_cast<uint32_t>(bits >> (9 * k)) & 511;
+            block[bit >> 3] |= static_cast<uint8_t>(1u << (bit & 7));
+        }
+    }
+
+    count_++;
+}
+
+bool AddressIndex::insert(const uint8_t* hash160) {
+    if (slots_ != 0 && probe(hash160)) {
+        return false;
+    }
+
+    make_writable();
+    if (slots_ == 0) {
+        allocate(slots_for(0));
+    } else if ((count_ + 1) * 5 > slots_ * 4) {
+        rehash(slots_ * 2);
+    }
+
+    place(hash160);
+    return true;
+}
+
+bool AddressIndex::bloom_test(const uint8_t* hash160) const {
+    const uint8_t* block = bloom_ + reduce(load32(hash160 + 8), bloom_blocks_) * 64;
+    uint64_t bits = load64(hash160 + 12);
+    for (size_t k = 0; k < BLOOM_PROBES; k++) {
+        uint32_t bit = static_cast<uint32_t>(bits >> (9 * k)) & 511;
+        if (!(block[bit >> 3] & (1u << (bit & 7)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AddressIndex::probe(const uint8_t* hash160) const {
+    uint32_t tag = tag_of(hash160);
+    size_t i = reduce(load32(hash160 + 4), slots_);
+
+    // Bounded so a damaged file without empty slots cannot spin forever
+    for (size_t n = 0; n < slots_; n++) {
+        uint32_t t = tags_[i];
+        if (t == 0) {
+            return false;
+        }
+        if (t == tag && memcmp(keys_ + i * 20, hash160, 20) == 0) {
+            return true;
+        }
+        if (++i == slots_) {
+            i = 0;
+        }
+    }
+    return false;
+}
+
+bool AddressIndex::contains(const uint8_t* hash160) const {
+    if (count_ == 0) {
+        return false;
+    }
+    if (bloom_blocks_ && !bloom_test(hash160)) {
+        return false;
+    }
+    return probe(hash160);
+}
+
+bool AddressIndex::contains_script(const uint8_t* script, size_t len) const {
+    if (len != 25 || script[0] != 0x76 || script[1] != 0xa9 || script[2] != 0x14 ||
+        script[23] != 0x88 || script[24] != 0xac) {
+        return false;
+    }
+    return contains(script + 3);
+}
+
+void AddressIndex::contains_many(const uint8_t* hashes, size_t count, uint8_t* out) const {
+    if (count_ == 0) {
+        memset(out, 0, count);
+        return;
+    }
+
+    thread_pool().parallel_for(count, 4096, [&](size_t begin, size_t end) {
+        for (size_t g = begin; g < end; g += BATCH_GROUP) {
+            size_t n = std::min(BATCH_GROUP, end - g);
+            const uint8_t* group = hashes + g * 20;
+
+            // Issue the first load of every key before waiting on any
+            for (size_t j = 0; j < n; j++) {
+                const uint8_t* h = group + j * 20;
+                if (bloom_blocks_) {
+                    DOGE_PREFETCH(bloom_ + reduce(load32(h + 8), bloom_blocks_) * 64);
+                } else {
+                    DOGE_PREFETCH(tags_ + reduce(load32(h + 4), slots_));
+                }
+            }
+            for (size_t j = 0; j < n; j++) {
+                out[g + j] = contains(group + j * 20) ? 1 : 0;
+            }
+        }
+    });
+}
+
+size_t AddressIndex::byte_size() const {
+    return slots_ == 0 ? 0 : layout_size(slots_, bloom_blocks_);
+}
+
+bool AddressIndex::save(const std::string& path) const {
+    AddressIndexHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = INDEX_VERSION;
+    header.byte_order = INDEX_BYTE_ORDER;
+    header.slot_count = slots_;
+    header.entry_count = count_;
+    header.bloom_blocks = bloom_blocks_;
+
+    // Write beside the target and rename over it: path may be the file this
+    // index (or another process's) is mapped from, and truncating it in
+    // place would pull the pages out from under base_
+    std::string tmp_path = path + ".tmp";
+    FILE* f = fopen(tmp_path.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    size_t body = byte_size() > 0 ? byte_size() - sizeof(header) : 0;
+    if (ok && body > 0) {
+        ok = fwrite(base_ + sizeof(header), 1, body, f) == body;
+    }
+    if (!sync_and_close(f) || !ok || !replace_file(tmp_path, path)) {
+        remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool AddressIndex::load(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path, true) || file.size() < sizeof(AddressIndexHeader)) {
+        return false;
+    }
+
+    AddressIndexHeader header;
+    memcpy(&header, file.data(), sizeof(header));
+    if (memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 || header.version != INDEX_VERSION ||
+        header.byte_order != INDEX_BYTE_ORDER) {
+        return false;
+    }
+
+    // Sizes are checked against the file before any pointer is formed. An
+    // empty index is saved as a bare header.
+    uint64_t slots = header.slot_count;
+    uint64_t blocks = header.bloom_blocks;
+    if (slots > file.size() / 24 || blocks > file.size() / 64 || header.entry_count > slots ||
+        layout_size(static_cast<size_t>(slots), static_cast<size_t>(blocks)) != file.size()) {
+        bool empty = slots == 0 && blocks == 0 && header.entry_count == 0 && file.size() == sizeof(header);
+        if (!empty) {
+            return false;
+        }
+    }
+
+    if (slots == 0) {
+        clear(bloom_enabled_);
+        return true;
+    }
+
+    clear(blocks != 0);
+    file_.swap(file);
+    slots_ = static_cast<size_t>(slots);
+    count_ = static_cast<size_t>(header.entry_count);
+    bloom_blocks_ = static_cast<size_t>(blocks);
+    base_ = file_.data();
+    bloom_ = base_ + sizeof(AddressIndexHeader);
+    tags_ = reinterpret_cast<const uint32_t*>(bloom_ + bloom_blocks_ * 64);
+    keys_ = reinterpret_cast<const uint8_t*>(tags_ + slots_);
+    return true;
+}
+
+} // namespace doge
@@ -0,0 +1,92 @@
+#ifndef DOGE_ADDRESS_INDEX_H
+#define DOGE_ADDRESS_INDEX_H
+
+#include "../utils/mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace doge {
+
+// Set of 20-byte pubkey hashes for "is this output ours?" checks against
+// millions of watched addresses.
+//
+// Keys live in a linear-probing table split into a 4-byte tag array and a
+// 20-byte key array, so a probe scans tags within one cache line and reads
+// a key only on a tag match. An optional blocked Bloom filter (~10 bits per
+// key, all probes in one 64-byte block) sits in front and answers most
+// misses from a far smaller, cache-resident array.
+//
+// The in-memory layout is also the file format: save() writes the buffer
+// and load() maps it back, so opening an index of any size parses nothing.
+// Const members may be called from any number of threads at once; insert()
+// and load() need exclusive access.
+class AddressIndex {
+public:
+    explicit AddressIndex(bool bloom_filter = true);
+
+    AddressIndex(const AddressIndex&) = delete;
+    AddressIndex& operator=(const AddressIndex&) = delete;
+
+    // Drop every key; the next insert starts a fresh table
+    void clear(bool bloom_filter);
+
+    // Size the table for count keys up front to avoid rehashing
+    void reserve(size_t count);
+
+    // Returns false if the key was already present. A mapped index is copied
+    // into memory on the first insert.
+    bool insert(const uint8_t* hash160);
+
+    bool contains(const uint8_t* hash160) const;
+
+    // Match a P2PKH scriptPubKey (OP_DUP OP_HASH160 <20> OP_EQUALVERIFY
+    // OP_CHECKSIG). Any other script is never a match.
+    bool contains_script(const uint8_t* script, size_t len) const;
+
+    // out[i] = contains(hashes + 20 * i). Lookups are interleaved so the
+    // cache misses of neighbouring keys overlap, and large batches are
+    // spread over the thread pool.
+    void contains_many(const uint8_t* hashes, size_t count, uint8_t* out) const;
+
+    size_t size() const { return count_; }
+    size_t capacity() const { return slots_; }
+    bool has_bloom_filter() const { return bloom_enabled_; }
+    bool is_mapped() const { return file_.is_open(); }
+
+    // Bytes of table, filter and header (the file size when saved)
+    size_t byte_size() const;
+
+    bool save(const std::string& path) const;
+
+    // Map a saved index. On failure the current contents are kept.
+    bool load(const std::string& path);
+
+private:
+    void allocate(size_t slots);
+    void rehash(size_t slots);
+    void place(const uint8_t* hash160);
+    bool bloom_test(const uint8_t* hash160) const;
+    bool probe(const uint8_t* hash160) const;
+    void make_writable();
+
+    bool bloom_enabled_;
+    size_t slots_ = 0;
+    size_t count_ = 0;
+    size_t bloom_blocks_ = 0;
+
+    // Point into owned_ or into file_
+    const uint8_t* base_ = nullptr;
+    const uint8_t* bloom_ = nullptr;
+    const uint32_t* tags_ = nullptr;
+    const uint8_t* keys_ = nullptr;
+
+    std::vector<uint8_t> owned_;
+    MappedFile file_;
+};
+
+} // namespace doge
+
+#endif // DOGE_ADDRESS_INDEX_H
@@ -6,53 +6,109 @@
 namespace doge {
 
 // Base58 alphabet (Bitcoin/Dogecoin standard)
-static const char* BASE58_ALPHABET = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+static constexpr char BASE58_ALPHABET[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
 
-std::string base58_encode(const uint8_t* data, size_t len) {
-    if (len == 0) return "";
+// 58^5, the largest power of 58 below 2^32. Each pass of long division by
+// it over 32-bit limbs yields five base58 digits at once.
+static const uint32_t BASE58_POW5 = 656356768;
+
+// Inputs up to this size are encoded entirely on the stack
+static const size_t BASE58_STACK_BYTES = 128;
 
-    // Count leading zeros
+// Encode data into out (at least base58_max_encoded_len(len) chars) using
+// caller-provided scratch: words holds (len + 3) / 4 limbs, digits holds
+// base58_max_encoded_len(len) + 5 entries. Returns the number of chars.
+static inline size_t base58_encode_limbs(const uint8_t* data, size_t len, char* out,
+                                         uint32_t* words, uint8_t* digits) {
     size_t leading_zeros = 0;
     while (leading_zeros < len && data[leading_zeros] == 0) {
         leading_zeros++;
     }
 
-    // Allocate enough space for base58 encoding (log(256)/log(58) ~= 1.37)
-    size_t size = len * 138 / 100 + 1;
-    std::vector<uint8_t> b58(size);
-
-    // Process the bytes
-    for (size_t i = 0; i < len; i++) {
-        uint32_t carry = data[i];
+    // Load as a big-endian number; the first limb takes the odd bytes
+    size_t nwords = (len + 3) / 4;
+    size_t head = len - (nwords - 1) * 4;
+    uint32_t w = 0;
+    for (size_t i = 0; i < head; i++) {
+        w = (w << 8) | data[i];
+    }
+    words[0] = w;
+    for (size_t i = 1; i < nwords; i++) {
+        const uint8_t* p = data + head + (i - 1) * 4;
+        words[i] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+    }
 
-        // Apply "b58 = b58 * 256 + carry"
-        for (size_t j = 0; j < size; j++) {
-            carry += 256 * b58[size - j - 1];
-            b58[size - j - 1] = carry % 58;
-            carry /= 58;
+    // Repeated division by 58^5, collecting digits least significant first
+    size_t ndigits = 0;
+    size_t start = 0;
+    while (start < nwords && words[start] == 0) start++;
+    while (start < nwords) {
+        uint64_t rem = 0;
+        for (size_t i = start; i < nwords; i++) {
+            uint64_t cur = (rem << 32) | words[i];
+            words[i] = static_cast<uint32_t>(cur / BASE58_POW5);
+            rem = cur % BASE58_POW5;
         }
+        uint32_t r = static_cast<uint32_t>(rem);
+        for (int k = 0; k < 5; k++) {
+            digits[ndigits++] = static_cast<uint8_t>(r % 58);
+            r /= 58;
+        }
+        while (start < nwords && words[start] == 0) start++;
     }
 
-    // Skip leading zeros in b58
-    size_t b58_leading_zeros = 0;
-    while (b58_leading_zeros < size && b58[b58_leading_zeros] == 0) {
-        b58_leading_zeros++;
+    // The last group may carry high zero digits
+    while (ndigits > 0 && digits[ndigits - 1] == 0) {
+        ndigits--;
     }
 
-    // Convert to base58 string
-    std::string result;
-    result.reserve(leading_zeros + size - b58_leading_zeros);
-
-    // Add '1' for each leading zero byte
+    // '1' for each leading zero byte, then the digits most significant first
+    size_t n = 0;
     for (size_t i = 0; i < leading_zeros; i++) {
-        result += '1';
+        out[n++] = '1';
+    }
+    while (ndigits > 0) {
+        out[n++] = BASE58_ALPHABET[digits[--ndigits]];
     }
+    return n;
+}
 
-    // Convert digits to base58 characters
-    for (size_t i = b58_leading_zeros; i < size; i++) {
-        result += BASE58_ALPHABET[b58[i]];
+// Fixed-width path: scratch sizes and loop bounds are compile-time constants
+template <size_t N>
+static size_t base58_encode_fixed(const uint8_t* data, char* out) {
+    uint32_t words[(N + 3) / 4];
+    uint8_t digits[base58_max_encoded_len(N) + 5];
+    return base58_encode_limbs(data, N, out, words, digits);
+}
+
+size_t base58_encode_to(const uint8_t* data, size_t len, char* out) {
+    switch (len) {
+        case 0: return 0;
+        case 25: return base58_encode_fixed<25>(data, out); // address
+        case 37: return base58_encode_fixed<37>(data, out); // WIF, uncompressed
+        case 38: return base58_encode_fixed<38>(data, out); // WIF, compressed
+        default: break;
+    }
+
+    if (len <= BASE58_STACK_BYTES) {
+        uint32_t words[(BASE58_STACK_BYTES + 3) / 4];
+        uint8_t digits[base58_max_encoded_len(BASE58_STACK_BYTES) + 5];
+        return base58_encode_limbs(data, len, out, words, digits);
     }
 
+    std::vector<uint32_t> words((len + 3) / 4);
+    std::vector<uint8_t> digits(base58_max_encoded_len(len) + 5);
+    return base58_encode_limbs(data, len, out, words.data(), digits.data());
+}
+
+std::string base58_encode(const uint8_t* data, size_t len) {
+    if (len <= BASE58_STACK_BYTES) {
+        char buf[base58_max_encoded_len(BASE58_STACK_BYTES)];
+        return std::string(buf, base58_encode_to(data, len, buf));
+    }
+
+    std::string result(base58_max_encoded_len(len), '\0');
+    result.resize(base58_encode_to(data, len, &result[0]));
     return result;
 }
 
@@ -60,100 +116,233 @@ std::string base58_encode(const std::vector<uint8_t>& data) {
     return base58_encode(data.data(), data.size());
 }
 
-bool base58_decode(const std::string& str, std::vector<uint8_t>& out) {
-    if (str.empty()) {
-        out.clear();
-        return true;
+// Reverse alphabet: digit value per byte, -1 for characters outside it
+struct Base58DecodeTable {
+    int8_t digit[256];
+};
+
+static constexpr Base58DecodeTable make_base58_decode_table() {
+    Base58DecodeTable table{};
+    for (int i = 0; i < 256; i++) {
+        table.digit[i] = -1;
+    }
+    for (int i = 0; i < 58; i++) {
+        table.digit[static_cast<uint8_t>(BASE58_ALPHABET[i])] = static_cast<int8_t>(i);
     }
+    return table;
+}
+
+static constexpr Base58DecodeTable BASE58_DECODE = make_base58_decode_table();
 
-    // Count leading '1's (zeros)
+// Upper bound on the decoded size of len chars (log(58)/log(256) ~= 0.733)
+static constexpr size_t base58_max_decoded_len(size_t len) {
+    return len * 733 / 1000 + 1;
+}
+
+// Strings up to this length (anything encoding BASE58_STACK_BYTES or less)
+// are decoded entirely on the stack
+static const size_t BASE58_STACK_CHARS = base58_max_encoded_len(BASE58_STACK_BYTES);
+
+// Decode len chars into out (cap bytes), using words as scratch for
+// (base58_max_decoded_len(len) + 3) / 4 limbs. Fails on a character outside
+// the alphabet or when the result does not fit in cap.
+static inline bool base58_decode_limbs(const char* str, size_t len, uint8_t* out, size_t cap,
+                                       size_t& out_len, uint32_t* words) {
     size_t leading_ones = 0;
-    while (leading_ones < str.size() && str[leading_ones] == '1') {
+    while (leading_ones < len && str[leading_ones] == '1') {
         leading_ones++;
     }
 
-    // Allocate enough space
-    size_t size = str.size() * 733 / 1000 + 1;
-    std::vector<uint8_t> b256(size);
-
-    // Process the characters
-    for (size_t i = 0; i < str.size(); i++) {
-        // Find character in alphabet
-        const char* p = strchr(BASE58_ALPHABET, str[i]);
-        if (!p) {
-            return false; // Invalid character
+    // words = words * 58^k + chunk for chunks of up to five digits, limbs
+    // stored least significant first. The first chunk takes the odd digits.
+    size_t used = 0;
+    size_t i = leading_ones;
+    while (i < len) {
+        size_t take = (len - i) % 5;
+        if (take == 0) take = 5;
+
+        uint32_t chunk = 0;
+        uint32_t mul = 1;
+        for (size_t k = 0; k < take; k++) {
+            int8_t d = BASE58_DECODE.digit[static_cast<uint8_t>(str[i++])];
+            if (d < 0) {
+                return false; // Invalid character
+            }
+            chunk = chunk * 58 + static_cast<uint32_t>(d);
+            mul *= 58;
         }
 
-        uint32_t carry = p - BASE58_ALPHABET;
+        uint64_t carry = chunk;
+        for (size_t j = 0; j < used; j++) {
+            carry += static_cast<uint64_t>(words[j]) * mul;
+            words[j] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+        if (carry) {
+            words[used++] = static_cast<uint32_t>(carry);
+        }
+    }
 
-        // Apply "b256 = b256 * 58 + carry"
-        for (size_t j = 0; j < size; j++) {
-            carry += 58 * b256[size - j - 1];
-            b256[size - j - 1] = carry % 256;
-            carry /= 256;
+    // Significant bytes of the top limb
+    size_t top_bytes = 0;
+    if (used > 0) {
+        uint32_t top = words[used - 1];
+        while (top) {
+            top_bytes++;
+            top >>= 8;
         }
     }
 
-    // Skip leading zeros in b256
-    size_t b256_leading_zeros = 0;
-    while (b256_leading_zeros < size && b256[b256_leading_zeros] == 0) {
-        b256_leading_zeros++;
+    size_t nbytes = used > 0 ? (used - 1) * 4 + top_bytes : 0;
+    if (leading_ones + nbytes > cap) {
+        return false;
     }
 
-    // Copy result
-    out.clear();
-    out.reserve(leading_ones + size - b256_leading_zeros);
+    // Zero byte for each leading '1', then the number big-endian
+    memset(out, 0, leading_ones);
+    uint8_t* p = out + leading_ones;
+    for (size_t k = top_bytes; k > 0; k--) {
+        *p++ = static_cast<uint8_t>(words[used - 1] >> (8 * (k - 1)));
+    }
+    for (size_t j = used > 0 ? used - 1 : 0; j > 0; j--) {
+        uint32_t w = words[j - 1];
+        p[0] = static_cast<uint8_t>(w >> 24);
+        p[1] = static_cast<uint8_t>(w >> 16);
+        p[2] = static_cast<uint8_t>(w >> 8);
+        p[3] = static_cast<uint8_t>(w);
+        p += 4;
+    }
 
-    // Add zero bytes for leading '1's
-    out.insert(out.end(), leading_ones, 0);
+    out_len = leading_ones + nbytes;
+    return true;
+}
 
-    // Copy the rest
-    out.insert(out.end(), b256.begin() + b256_leading_zeros, b256.end());
+bool base58_decode(const std::string& str, std::vector<uint8_t>& out) {
+    // Every char yields at most one byte
+    out.resize(str.size());
+    std::vector<uint32_t> words((base58_max_decoded_len(str.size()) + 3) / 4);
 
+    size_t n;
+    if (!base58_decode_limbs(str.data(), str.size(), out.data(), out.size(), n, words.data())) {
+        out.clear();
+        return false;
+    }
+    out.resize(n);
     return true;
 }
 
-std::string base58check_encode(const uint8_t* data, size_t len) {
-    // Calculate checksum: first 4 bytes of SHA256(SHA256(data))
+// SHA256(SHA256(payload)), using the fixed-length paths for addresses
+// (21 bytes) and WIF keys (33/34 bytes)
+static void checksum_hash(const uint8_t* data, size_t len, uint8_t* hash) {
+    switch (len) {
+        case 21: sha256_double_fixed<21>(data, hash); break;
+        case 33: sha256_double_fixed<33>(data, hash); break;
+        case 34: sha256_double_fixed<34>(data, hash); break;
+        default: sha256_double(data, len, hash); break;
+    }
+}
+
+size_t base58check_encode_to(const uint8_t* data, size_t len, char* out) {
+    // Payload and checksum side by side, on the stack for the usual sizes
+    uint8_t stack_buf[BASE58_STACK_BYTES];
+    std::vector<uint8_t> heap_buf;
+    uint8_t* buf = stack_buf;
+    if (len + 4 > BASE58_STACK_BYTES) {
+        heap_buf.resize(len + 4);
+        buf = heap_buf.data();
+    }
+
+    // Checksum: first 4 bytes of SHA256(SHA256(data))
     uint8_t hash[32];
-    sha256_double(data, len, hash);
+    checksum_hash(data, len, hash);
 
-    // Append checksum to data
-    std::vector<uint8_t> with_checksum(data, data + len);
-    with_checksum.insert(with_checksum.end(), hash, hash + 4);
+    memcpy(buf, data, len);
+    memcpy(buf + len, hash, 4);
 
-    return base58_encode(with_checksum);
+    return base58_encode_to(buf, len + 4, out);
+}
+
+std::string base58check_encode(const uint8_t* data, size_t len) {
+    if (len + 4 <= BASE58_STACK_BYTES) {
+        char out[base58_max_encoded_len(BASE58_STACK_BYTES)];
+        return std::string(out, base58check_encode_to(data, len, out));
+    }
+
+    std::string result(base58_max_encoded_len(len + 4), '\0');
+    result.resize(base58check_encode_to(data, len, &result[0]));
+    return result;
 }
 
 std::string base58check_encode(const std::vector<uint8_t>& data) {
     return base58check_encode(data.data(), data.size());
 }
 
-bool base58check_decode(const std::string& str, std::vector<uint8_t>& out) {
-    std::vector<uint8_t> decoded;
-    if (!base58_decode(str, decoded)) {
+// Decode str and verify its checksum with the payload left at the front of
+// buf (cap bytes, including room for the checksum)
+static bool base58check_decode_buf(const char* str, size_t len, uint8_t* buf, size_t cap,
+                                   size_t& payload_len, uint32_t* words) {
+    size_t n;
+    if (!base58_decode_limbs(str, len, buf, cap, n, words)) {
         return false;
     }
 
-    if (decoded.size() < 4) {
+    if (n < 4) {
         return false; // Too short for checksum
     }
 
-    // Split data and checksum
-    size_t payload_len = decoded.size() - 4;
-    std::vector<uint8_t> payload(decoded.begin(), decoded.begin() + payload_len);
-    std::vector<uint8_t> checksum(decoded.begin() + payload_len, decoded.end());
-
     // Verify checksum
+    payload_len = n - 4;
     uint8_t hash[32];
-    sha256_double(payload.data(), payload.size(), hash);
+    checksum_hash(buf, payload_len, hash);
 
-    if (memcmp(hash, checksum.data(), 4) != 0) {
-        return false; // Checksum mismatch
-    }
+    return memcmp(hash, buf + payload_len, 4) == 0;
+}
+
+bool base58check_decode(const std::string& str, std::vector<uint8_t>& out) {
+    out.resize(str.size());
+    std::vector<uint32_t> words((base58_max_decoded_len(str.size()) + 3) / 4);
 
-    out = payload;
+    size_t payload_len;
+    if (!base58check_decode_buf(str.data(), str.size(), out.data(), out.size(),
+                                payload_len, words.data())) {
+        out.clear();
+        return false;
+    }
+    out.resize(payload_len);
     return true;
 }
 
+size_t base58check_decode_into(const char* str, size_t len, uint8_t* out, size_t cap) {
+    if (len > BASE58_STACK_CHARS) {
+        // Each char after the first adds at least log256(58) bytes, so a
+        // string this long that cannot fit cap fails before decoding
+        if ((len - 1) * 732 / 1000 > cap + 4) {
+            return 0;
+        }
+
+        std::vector<uint8_t> payload;
+        if (!base58check_decode(std::string(str, len), payload) || payload.size() > cap) {
+            return 0;
+        }
+        memcpy(out, payload.data(), payload.size());
+        return payload.size();
+    }
+
+    uint8_t buf[base58_max_decoded_len(BASE58_STACK_CHARS)];
+    uint32_t words[(base58_max_decoded_len(BASE58_STACK_CHARS) + 3) / 4];
+
+    size_t payload_len;
+    if (!base58check_decode_buf(str, len, buf, std::min(cap, sizeof(buf) - 4) + 4,
+                                payload_len, words)) {
+        return 0;
+    }
+
+    memcpy(out, buf, payload_len);
+    return payload_len;
+}
+
+size_t base58check_decode_into(const std::string& str, uint8_t* out, size_t cap) {
+    return base58check_decode_into(str.data(), str.size(), out, cap);
+}
+
 } // namespace doge
@@ -7,10 +7,20 @@
 
 namespace doge {
 
+// Upper bound on the base58 length of len bytes (log(256)/log(58) ~= 1.37)
+constexpr size_t base58_max_encoded_len(size_t len) {
+    return len * 138 / 100 + 1;
+}
+
 // Base58 encoding/decoding (without checksum)
 std::string base58_encode(const uint8_t* data, size_t len);
 std::string base58_encode(const std::vector<uint8_t>& data);
 
+// Allocation-free encoding into out, which must hold at least
+// base58_max_encoded_len(len) chars. Returns the number of chars written
+// (no terminator).
+size_t base58_encode_to(const uint8_t* data, size_t len, char* out);
+
 bool base58_decode(const std::string& str, std::vector<uint8_t>& out);
 
 // Base58Check encoding/decoding (with checksum)
@@ -18,8 +28,19 @@ bool base58_decode(const std::string& str, std::vector<uint8_t>& out);
 std::string base58check_encode(const uint8_t* data, size_t len);
 std::string base58check_encode(const std::vector<uint8_t>& data);
 
+// As base58_encode_to; out must hold base58_max_encoded_len(len + 4) chars
+size_t base58check_encode_to(const uint8_t* data, size_t len, char* out);
+
 bool base58check_decode(const std::string& str, std::vector<uint8_t>& out);
 
+// Decode and verify into caller storage. Strings encoding up to 128 bytes
+// (every key and address format) are decoded on the stack; longer ones
+// fall back to the heap path. Returns the payload length, or 0 if the
+// string is invalid, fails its checksum, or the payload does not fit in cap
+// bytes.
+size_t base58check_decode_into(const char* str, size_t len, uint8_t* out, size_t cap);
+size_t base58check_decode_into(const std::string& str, uint8_t* out, size_t cap);
+
 } // namespace doge
 
 #endif // DOGE_BASE58_H
@@ -0,0 +1,399 @@
+#include "bip32.h"
+#include "base58.h"
+#include "entropy.h"
+#include "secp256k1_context.h"
+#include "../utils/hash.h"
+#include "../utils/thread_pool.h"
+#include <atomic>
+#include <cstring>
+
+namespace doge {
+
+ExtendedKey ExtendedKey::neutered() const {
+    ExtendedKey out = *this;
+    secure_wipe(out.private_key, sizeof(out.private_key));
+    out.has_private = false;
+    return out;
+}
+
+void ExtendedKey::fingerprint(uint8_t* out) const {
+    uint8_t hash[20];
+    hash160_fixed<33>(public_key, hash);
+    memcpy(out, hash, 4);
+}
+
+void ExtendedKey::wipe() {
+    secure_wipe(private_key, sizeof(private_key));
+    secure_wipe(chain_code, sizeof(chain_code));
+    has_private = false;
+}
+
+static bool serialize_point(secp256k1_context* ctx, const secp256k1_pubkey& point, uint8_t* out) {
+    size_t len = 33;
+    return secp256k1_ec_pubkey_serialize(ctx, out, &len, &point, SECP256K1_EC_COMPRESSED) != 0;
+}
+
+static bool public_from_private(secp256k1_context* ctx, const uint8_t* private_key, uint8_t* public_key) {
+    secp256k1_pubkey point;
+    return secp256k1_ec_pubkey_create(ctx, &point, private_key) &&
+           serialize_point(ctx, point, public_key);
+}
+
+// One CKD step. hmac is keyed with the parent's chain code and
+// parent_point is the parsed parent public key (only used for public
+// parents). Writes the child's public key, its secret when the parent has
+// one, and I_R when chain_code is not null.
+static bool derive_step(secp256k1_context* ctx, const HmacSha512& hmac,
+                        const ExtendedKey& parent, const secp256k1_pubkey* parent_point,
+                        uint32_t index, uint8_t* private_key, uint8_t* public_key,
+                        uint8_t* chain_code) {
+    uint8_t data[37];
+    if (index & BIP32_HARDENED) {
+        if (!parent.has_private) {
+            return false;
+        }
+        data[0] = 0;
+        memcpy(data + 1, parent.private_key, 32);
+    } else {
+        memcpy(data, parent.public_key, 33);
+    }
+    data[33] = static_cast<uint8_t>(index >> 24);
+    data[34] = static_cast<uint8_t>(index >> 16);
+    data[35] = static_cast<uint8_t>(index >> 8);
+    data[36] = static_cast<uint8_t>(index);
+
+    uint8_t I[64];
+    hmac.mac(data, sizeof(data), I);
+    secure_wipe(data, sizeof(data));
+
+    bool ok;
+    if (parent.has_private) {
+        // k_i = I_L + k_par, then one generator multiplication for K_i
+        memcpy(private_key, parent.private_key, 32);
+        ok = secp256k1_ec_seckey_tweak_add(ctx, private_key, I) &&
+             public_from_private(ctx, private_key, public_key);
+    } else {
+        // K_i = I_L*G + K_par. pubkey_create uses the fast generator tables,
+        // unlike pubkey_tweak_add's generic multiplication.
+        secp256k1_pubkey tweak;
+        secp256k1_pubkey child;
+        const secp256k1_pubkey* points[2] = {parent_point, &tweak};
+        ok = secp256k1_ec_pubkey_create(ctx, &tweak, I) &&
+             secp256k1_ec_pubkey_combine(ctx, &child, points, 2) &&
+             serialize_point(ctx, child, public_key);
+    }
+
+    if (ok && chain_code) {
+        memcpy(chain_code, I + 32, 32);
+    }
+    secure_wipe(I, sizeof(I));
+    return ok;
+}
+
+bool bip32_master_from_seed(const uint8_t* seed, size_t len, ExtendedKey& out) {
+    if (len < 16 || len > 64) {
+        return false;
+    }
+
+    static const uint8_t KEY[] = {'B', 'i', 't', 'c', 'o', 'i', 'n', ' ', 's', 'e', 'e', 'd'};
+    uint8_t I[64];
+    hmac_sha512(KEY, sizeof(KEY), seed, len, I);
+
+    out = ExtendedKey();
+    memcpy(out.private_key, I, 32);
+    memcpy(out.chain_code, I + 32, 32);
+    out.has_private = true;
+    secure_wipe(I, sizeof(I));
+
+    secp256k1_context* ctx = secp256k1_thread_context();
+    if (!secp256k1_ec_seckey_verify(ctx, out.private_key) ||
+        !public_from_private(ctx, out.private_key, out.public_key)) {
+        out.wipe();
+        return false;
+    }
+    return true;
+}
+
+bool bip32_derive_child(const ExtendedKey& parent, uint32_t index, ExtendedKey& child) {
+    if (parent.depth == 0xff) {
+        return false;
+    }
+
+    secp256k1_context* ctx = secp256k1_thread_context();
+    secp256k1_pubkey parent_point;
+    if (!parent.has_private &&
+        !secp256k1_ec_pubkey_parse(ctx, &parent_point, parent.public_key, 33)) {
+        return false;
+    }
+
+    ExtendedKey result;
+    HmacSha512 hmac(parent.chain_code, 32);
+    if (!derive_step(ctx, hmac, parent, &parent_point, index,
+                     result.private_key, result.public_key, result.chain_code)) {
+        result.wipe();
+        return false;
+    }
+
+    result.depth = parent.depth + 1;
+    parent.fingerprint(result.parent_fingerprint);
+    result.child_number = index;
+    result.has_private = parent.has_private;
+
+    child = result;
+    result.wipe();
+    return true;
+}
+
+bool bip32_parse_path(const std::string& path, std::vector<uint32_t>& out) {
+    out.clear();
+    if (path.empty() || path[0] != 'm') {
+        return false;
+    }
+
+    size_t i = 1;
+    while (i < path.size()) {
+        if (path[i] != '/' || i + 1 >= path.size()) {
+            return false;
+        }
+        i++;
+
+        uint64_t value = 0;
+        size_t digits = 0;
+        while (i < path.size() && path[i] >= '0' && path[i] <= '9') {
+            value = value * 10 + static_cast<uint64_t>(path[i] - '0');
+            if (value >= BIP32_HARDENED) {
+                return false;
+            }
+            i++;
+            digits++;
+        }
+        if (digits == 0) {
+            return false;
+        }
+
+        if (i < path.size() && (path[i] == '\'' || path[i] == 'h' || path[i] == 'H')) {
+            value |= BIP32_HARDENED;
+            i++;
+        }
+        out.push_back(static_cast<uint32_t>(value));
+    }
+    return true;
+}
+
+std::string bip32_serialize(const ExtendedKey& key, bool mainnet) {
+    uint32_t version = key.has_private
+        ? (mainnet ? BIP32_VERSION_MAINNET_PRIVATE : BIP32_VERSION_TESTNET_PRIVATE)
+        : (mainnet ? BIP32_VERSION_MAINNET_PUBLIC : BIP32_VERSION_TESTNET_PUBLIC);
+
+    uint8_t data[78];
+    data[0] = static_cast<uint8_t>(version >> 24);
+    data[1] = static_cast<uint8_t>(version >> 16);
+    data[2] = static_cast<uint8_t>(version >> 8);
+    data[3] = static_cast<uint8_t>(version);
+    data[4] = key.depth;
+    memcpy(data + 5, key.parent_fingerprint, 4);
+    data[9] = static_cast<uint8_t>(key.child_number >> 24);
+    data[10] = static_cast<uint8_t>(key.child_number >> 16);
+    data[11] = static_cast<uint8_t>(key.child_number >> 8);
+    data[12] = static_cast<uint8_t>(key.child_number);
+    memcpy(data + 13, key.chain_code, 32);
+    if (key.has_private) {
+        data[45] = 0;
+        memcpy(data + 46, key.private_key, 32);
+    } else {
+        memcpy(data + 45, key.public_key, 33);
+    }
+
+    std::string result = base58check_encode(data, sizeof(data));
+    secure_wipe(data, sizeof(data));
+    return result;
+}
+
+bool bip32_deserialize(const std::string& str, ExtendedKey& out, bool& mainnet) {
+    uint8_t data[78];
+    if (base58check_decode_into(str, data, sizeof(data)) != sizeof(data)) {
+        return false;
+    }
+
+    uint32_t version = (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+                       (static_cast<uint32_t>(data[2]) << 8) | data[3];
+    bool is_private;
+    if (version == BIP32_VERSION_MAINNET_PRIVATE) {
+        mainnet = true;
+        is_private = true;
+    } else if (version == BIP32_VERSION_MAINNET_PUBLIC) {
+        mainnet = true;
+        is_private = false;
+    } else if (version == BIP32_VERSION_TESTNET_PRIVATE) {
+        mainnet = false;
+        is_private = true;
+    } else if (version == BIP32_VERSION_TESTNET_PUBLIC) {
+        mainnet = false;
+        is_private = false;
+    } else {
+        return false;
+    }
+
+    ExtendedKey key;
+    key.depth = data[4];
+    memcpy(key.parent_fingerprint, data + 5, 4);
+    key.child_number = (static_cast<uint32_t>(data[9]) << 24) | (static_cast<uint32_t>(data[10]) << 16) |
+                       (static_cast<uint32_t>(data[11]) << 8) | data[12];
+    memcpy(key.chain_code, data + 13, 32);
+
+    // A master key has no parent
+    static const uint8_t ZERO[4] = {};
+    if (key.depth == 0 && (key.child_number != 0 || memcmp(key.parent_fingerprint, ZERO, 4) != 0)) {
+        secure_wipe(data, sizeof(data));
+        return false;
+    }
+
+    secp256k1_context* ctx = secp256k1_thread_context();
+    bool ok;
+    if (is_private) {
+        memcpy(key.private_key, data + 46, 32);
+        key.has_private = true;
+        ok = data[45] == 0 &&
+             secp256k1_ec_seckey_verify(ctx, key.private_key) &&
+             public_from_private(ctx, key.private_key, key.public_key);
+    } else {
+        secp256k1_pubkey point;
+        memcpy(key.public_key, data + 45, 33);
+        ok = (data[45] == 0x02 || data[45] == 0x03) &&
+             secp256k1_ec_pubkey_parse(ctx, &point, key.public_key, 33);
+    }
+    secure_wipe(data, sizeof(data));
+
+    if (!ok) {
+        key.wipe();
+        return false;
+    }
+    out = key;
+    key.wipe();
+    return true;
+}
+
+bool bip32_derive_range(const ExtendedKey& parent, uint32_t start, size_t count,
+                        uint8_t* public_keys, uint8_t* pubkey_hashes,
+                        uint8_t* private_keys) {
+    if (count == 0) {
+        return true;
+    }
+    if (count > BIP32_HARDENED || start > BIP32_HARDENED - count) {
+        return false;
+    }
+
+    secp256k1_pubkey parent_point;
+    if (!parent.has_private &&
+        !secp256k1_ec_pubkey_parse(secp256k1_thread_context(), &parent_point, parent.public_key, 33)) {
+        return false;
+    }
+
+    const HmacSha512 hmac(parent.chain_code, 32);
+    bool want_private = parent.has_private && private_keys != nullptr;
+    std::atomic<bool> ok(true);
+
+    thread_pool().parallel_for(count, 64, [&](size_t begin, size_t end) {
+        secp256k1_context* ctx = secp256k1_thread_context();
+        uint8_t scratch[32];
+
+        for (size_t i = begin; i < end; i++) {
+            uint8_t* secret = want_private ? private_keys + i * 32 : scratch;
+            if (!derive_step(ctx, hmac, parent, &parent_point, start + static_cast<uint32_t>(i),
+                             secret, public_keys + i * 33, nullptr)) {
+                ok = false;
+                break;
+            }
+        }
+        secure_wipe(scratch, sizeof(scratch));
+
+        hash160_many(public_keys + begin * 33, 33, end - begin, pubkey_hashes + begin * 20);
+    });
+
+    return ok;
+}
+
+Bip32Keychain::~Bip32Keychain() {
+    clear_cache();
+    root_.wipe();
+}
+
+void Bip32Keychain::set_root(const ExtendedKey& root) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : nodes_) {
+        entry.second.wipe();
+    }
+    nodes_.clear();
+    root_ = root;
+}
+
+bool Bip32Keychain::derive_cached(const std::vector<uint32_t>& path, size_t cache_depth, ExtendedKey& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Deepest cached ancestor (or the root)
+    size_t depth = path.size();
+    const ExtendedKey* node = &root_;
+    std::vector<uint32_t> prefix(path);
+    for (; depth > 0; depth--) {
+        prefix.resize(depth);
+        auto it = nodes_.find(prefix);
+        if (it != nodes_.end()) {
+            node = &it->second;
+            break;
+        }
+    }
+
+    // Derive the rest, remembering each node down to cache_depth
+    ExtendedKey leaf;
+    for (; depth < path.size(); depth++) {
+        ExtendedKey child;
+        if (!bip32_derive_child(*node, path[depth], child)) {
+            leaf.wipe();
+            return false;
+        }
+        if (depth < cache_depth) {
+            prefix.assign(path.begin(), path.begin() + depth + 1);
+            node = &(nodes_[prefix] = child);
+        } else {
+            leaf = child;
+            node = &leaf;
+        }
+        child.wipe();
+    }
+
+    out = *node;
+    leaf.wipe();
+    return true;
+}
+
+bool Bip32Keychain::derive(const std::vector<uint32_t>& path, ExtendedKey& out) {
+    return derive_cached(path, path.empty() ? 0 : path.size() - 1, out);
+}
+
+bool Bip32Keychain::derive_range(const std::vector<uint32_t>& parent_path, uint32_t start, size_t count,
+                                 uint8_t* public_keys, uint8_t* pubkey_hashes,
+                                 uint8_t* private_keys) {
+    // The parent is reused by the next range, so it is cached too
+    ExtendedKey parent;
+    if (!derive_cached(parent_path, parent_path.size(), parent)) {
+        return false;
+    }
+    bool ok = bip32_derive_range(parent, start, count, public_keys, pubkey_hashes, private_keys);
+    parent.wipe();
+    return ok;
+}
+
+size_t Bip32Keychain::cached_nodes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nodes_.size();
+}
+
+void Bip32Keychain::clear_cache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : nodes_) {
+        entry.second.wipe();
+    }
+    nodes_.clear();
+}
+
+} // namespace doge
@@ -0,0 +1,104 @@
+#ifndef DOGE_BIP32_H
+#define DOGE_BIP32_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace doge {
+
+// Extended key version bytes (dgpv / dgub on mainnet, tprv / tpub on testnet)
+const uint32_t BIP32_VERSION_MAINNET_PRIVATE = 0x02fac398;
+const uint32_t BIP32_VERSION_MAINNET_PUBLIC = 0x02facafd;
+const uint32_t BIP32_VERSION_TESTNET_PRIVATE = 0x04358394;
+const uint32_t BIP32_VERSION_TESTNET_PUBLIC = 0x043587cf;
+
+const uint32_t BIP32_HARDENED = 0x80000000;
+
+// A BIP32 node. The compressed public key is always filled in, so public
+// derivation and fingerprints never need an extra EC multiplication.
+struct ExtendedKey {
+    uint8_t depth = 0;
+    uint8_t parent_fingerprint[4] = {};
+    uint32_t child_number = 0;
+    uint8_t chain_code[32] = {};
+    uint8_t private_key[32] = {};
+    uint8_t public_key[33] = {};
+    bool has_private = false;
+
+    // Drop the private half (xprv -> xpub)
+    ExtendedKey neutered() const;
+
+    // First 4 bytes of hash160(public_key)
+    void fingerprint(uint8_t* out) const;
+
+    void wipe();
+};
+
+// Master node from a seed of 16 to 64 bytes (HMAC-SHA512 keyed "Bitcoin seed")
+bool bip32_master_from_seed(const uint8_t* seed, size_t len, ExtendedKey& out);
+
+// CKDpriv or CKDpub, depending on whether parent has its private key.
+// Hardened children need the private key. Fails for the ~2^-127 indices
+// that give an invalid key; BIP32 callers move on to the next index.
+bool bip32_derive_child(const ExtendedKey& parent, uint32_t index, ExtendedKey& child);
+
+// Parse "m/44'/3'/0'/0/5" (' or h marks a hardened index). "m" alone is
+// the empty path.
+bool bip32_parse_path(const std::string& path, std::vector<uint32_t>& out);
+
+// Base58Check xprv / xpub forms with the Dogecoin version bytes
+std::string bip32_serialize(const ExtendedKey& key, bool mainnet = true);
+bool bip32_deserialize(const std::string& str, ExtendedKey& out, bool& mainnet);
+
+// Derive children start .. start + count - 1 of parent, writing count * 33
+// compressed public keys, count * 20 hash160s and, when private_keys is not
+// null and the parent is private, count * 32 secrets. The parent's HMAC
+// pads are absorbed once and the children are spread over the thread pool.
+// Hardened indices are rejected: scanning ranges are always normal children.
+bool bip32_derive_range(const ExtendedKey& parent, uint32_t start, size_t count,
+                        uint8_t* public_keys, uint8_t* pubkey_hashes,
+                        uint8_t* private_keys = nullptr);
+
+// A root node plus the parent nodes derived from it so far, keyed by path.
+// An account's external chain (m/44'/3'/0'/0) is derived once; each later
+// address or range under it costs only the last step. Leaf nodes are not
+// kept, so a gap-limit scan does not grow the cache. Thread safe.
+class Bip32Keychain {
+public:
+    Bip32Keychain() = default;
+    ~Bip32Keychain();
+
+    Bip32Keychain(const Bip32Keychain&) = delete;
+    Bip32Keychain& operator=(const Bip32Keychain&) = delete;
+
+    void set_root(const ExtendedKey& root);
+    const ExtendedKey& root() const { return root_; }
+
+    // Node at path, reusing the deepest cached ancestor. Every node above
+    // the last step is cached; the node itself is not.
+    bool derive(const std::vector<uint32_t>& path, ExtendedKey& out);
+
+    // bip32_derive_range under the (cached) node at parent_path
+    bool derive_range(const std::vector<uint32_t>& parent_path, uint32_t start, size_t count,
+                      uint8_t* public_keys, uint8_t* pubkey_hashes,
+                      uint8_t* private_keys = nullptr);
+
+    size_t cached_nodes();
+    void clear_cache();
+
+private:
+    // derive() caching the nodes at depths 1 .. cache_depth of path
+    bool derive_cached(const std::vector<uint32_t>& path, size_t cache_depth, ExtendedKey& out);
+
+    ExtendedKey root_;
+    std::map<std::vector<uint32_t>, ExtendedKey> nodes_;
+    std::mutex mutex_;
+};
+
+} // namespace doge
+
+#endif // DOGE_BIP32_H
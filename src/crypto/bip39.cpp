@@ -0,0 +1,171 @@
+#include "bip39.h"
+#include "entropy.h"
+#include "../utils/hash.h"
+#include <cstring>
+
+namespace doge {
+
+static const uint32_t BIP39_ITERATIONS = 2048;
+
+int bip39_word_index(const char* word, size_t len) {
+    int lo = 0;
+    int hi = 2047;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        const char* candidate = BIP39_WORDLIST[mid];
+        int cmp = strncmp(candidate, word, len);
+        if (cmp == 0 && candidate[len] != '\0') {
+            cmp = 1; // candidate is longer, so it sorts after word
+        }
+        if (cmp == 0) {
+            return mid;
+        }
+        if (cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return -1;
+}
+
+bool bip39_entropy_to_mnemonic(const uint8_t* entropy, size_t len, std::string& mnemonic) {
+    if (len < 16 || len > 32 || len % 4 != 0) {
+        return false;
+    }
+
+    // Entropy followed by len / 4 checksum bits from its SHA-256
+    uint8_t bits[33];
+    memcpy(bits, entropy, len);
+    uint8_t hash[32];
+    sha256(entropy, len, hash);
+    bits[len] = hash[0];
+
+    size_t word_count = (len * 8 + len / 4) / 11;
+    mnemonic.clear();
+    mnemonic.reserve(word_count * 9);
+
+    for (size_t i = 0; i < word_count; i++) {
+        uint32_t index = 0;
+        for (size_t b = i * 11; b < i * 11 + 11; b++) {
+            index = (index << 1) | ((bits[b / 8] >> (7 - b % 8)) & 1);
+        }
+        if (i > 0) {
+            mnemonic += ' ';
+        }
+        mnemonic += BIP39_WORDLIST[index];
+    }
+
+    secure_wipe(bits, sizeof(bits));
+    return true;
+}
+
+bool bip39_generate_mnemonic(size_t word_count, std::string& mnemonic) {
+    if (word_count < 12 || word_count > 24 || word_count % 3 != 0) {
+        return false;
+    }
+
+    size_t len = word_count * 4 / 3;
+    uint8_t entropy[32];
+    if (!random_bytes(entropy, len)) {
+        return false;
+    }
+
+    bool ok = bip39_entropy_to_mnemonic(entropy, len, mnemonic);
+    secure_wipe(entropy, sizeof(entropy));
+    return ok;
+}
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Find the word at or after pos, leaving pos just past it. Returns false
+// once only whitespace is left.
+static bool next_word(const std::string& mnemonic, size_t& pos, size_t& start) {
+    while (pos < mnemonic.size() && is_space(mnemonic[pos])) {
+        pos++;
+    }
+    start = pos;
+    while (pos < mnemonic.size() && !is_space(mnemonic[pos])) {
+        pos++;
+    }
+    return start != pos;
+}
+
+bool bip39_mnemonic_to_entropy(const std::string& mnemonic, std::vector<uint8_t>& entropy) {
+    uint8_t bits[33] = {};
+    size_t word_count = 0;
+
+    size_t i = 0;
+    size_t start;
+    while (next_word(mnemonic, i, start)) {
+        int index = bip39_word_index(mnemonic.data() + start, i - start);
+        if (index < 0 || word_count == 24) {
+            secure_wipe(bits, sizeof(bits));
+            return false;
+        }
+        for (int b = 0; b < 11; b++) {
+            size_t pos = word_count * 11 + b;
+            if ((index >> (10 - b)) & 1) {
+                bits[pos / 8] |= static_cast<uint8_t>(0x80 >> (pos % 8));
+            }
+        }
+        word_count++;
+    }
+
+    if (word_count < 12 || word_count % 3 != 0) {
+        secure_wipe(bits, sizeof(bits));
+        return false;
+    }
+
+    size_t len = word_count * 4 / 3;
+    size_t checksum_bits = len / 4;
+    uint8_t hash[32];
+    sha256(bits, len, hash);
+    uint8_t mask = static_cast<uint8_t>(0xff << (8 - checksum_bits));
+    bool ok = (hash[0] & mask) == (bits[len] & mask);
+
+    if (ok) {
+        entropy.assign(bits, bits + len);
+    }
+    secure_wipe(bits, sizeof(bits));
+    return ok;
+}
+
+bool bip39_validate_mnemonic(const std::string& mnemonic) {
+    std::vector<uint8_t> entropy;
+    bool ok = bip39_mnemonic_to_entropy(mnemonic, entropy);
+    secure_wipe(entropy.data(), entropy.size());
+    return ok;
+}
+
+void bip39_normalize_mnemonic(const std::string& mnemonic, std::string& normalized) {
+    normalized.clear();
+    normalized.reserve(mnemonic.size());
+
+    size_t i = 0;
+    size_t start;
+    while (next_word(mnemonic, i, start)) {
+        if (!normalized.empty()) {
+            normalized += ' ';
+        }
+        normalized.append(mnemonic, start, i - start);
+    }
+}
+
+void bip39_mnemonic_to_seed(const std::string& mnemonic, const std::string& passphrase,
+                            uint8_t* seed) {
+    // Hash the words as validation read them, not as they were pasted
+    std::string words;
+    bip39_normalize_mnemonic(mnemonic, words);
+
+    std::string salt = "mnemonic" + passphrase;
+    pbkdf2_hmac_sha512(reinterpret_cast<const uint8_t*>(words.data()), words.size(),
+                       reinterpret_cast<const uint8_t*>(salt.data()), salt.size(),
+                       BIP39_ITERATIONS, seed, 64);
+    secure_wipe(&words[0], words.size());
+    secure_wipe(&salt[0], salt.size());
+}
+
+} // namespace doge
@@ -0,0 +1,43 @@
+#ifndef DOGE_BIP39_H
+#define DOGE_BIP39_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace doge {
+
+// English wordlist (bip39_wordlist.cpp), in sorted order
+extern const char* const BIP39_WORDLIST[2048];
+
+// Position of a word in the wordlist, or -1
+int bip39_word_index(const char* word, size_t len);
+
+// Mnemonic for 16, 20, 24, 28 or 32 bytes of entropy (12 to 24 words)
+bool bip39_entropy_to_mnemonic(const uint8_t* entropy, size_t len, std::string& mnemonic);
+
+// Fresh mnemonic of 12, 15, 18, 21 or 24 words
+bool bip39_generate_mnemonic(size_t word_count, std::string& mnemonic);
+
+// Decode a mnemonic back to its entropy. Fails on unknown words, a bad
+// word count or a checksum mismatch. Words may be separated by any run of
+// whitespace.
+bool bip39_mnemonic_to_entropy(const std::string& mnemonic, std::vector<uint8_t>& entropy);
+bool bip39_validate_mnemonic(const std::string& mnemonic);
+
+// The words of a mnemonic joined by single spaces, dropping leading,
+// trailing and repeated whitespace as bip39_mnemonic_to_entropy() does
+void bip39_normalize_mnemonic(const std::string& mnemonic, std::string& normalized);
+
+// 64-byte seed: PBKDF2-HMAC-SHA512(mnemonic, "mnemonic" + passphrase, 2048).
+// The mnemonic goes through bip39_normalize_mnemonic() first, so a padded
+// or double-spaced paste gives the same wallet as the words typed cleanly;
+// the passphrase is used byte for byte. BIP39 asks for NFKD normalization,
+// which changes nothing for English words and ASCII passphrases.
+void bip39_mnemonic_to_seed(const std::string& mnemonic, const std::string& passphrase,
+                            uint8_t* seed);
+
+} // namespace doge
+
+#endif // DOGE_BIP39_H
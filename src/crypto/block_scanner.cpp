@@ -0,0 +1,327 @@
+#include "block_scanner.h"
+#include "../utils/hash.h"
+#include "../utils/thread_pool.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace doge {
+
+// Smallest serialized transaction: version, one input, no outputs, lock time
+static const size_t MIN_TX_SIZE = 4 + 1 + 41 + 1 + 4;
+
+uint32_t BlockView::version() const {
+    return read_le32(data);
+}
+
+static bool read_merkle_branch(ByteReader& reader, const uint8_t*& branch, size_t& depth, uint32_t& index) {
+    uint64_t count;
+    if (!reader.read_varint(count) || count > reader.remaining() / 32) {
+        return false;
+    }
+    depth = static_cast<size_t>(count);
+    return reader.read_span(depth * 32, branch) && reader.read_le32(index);
+}
+
+bool parse_header(const uint8_t* data, size_t len, HeaderView& header) {
+    if (len < BLOCK_HEADER_SIZE) {
+        return false;
+    }
+
+    HeaderView out;
+    out.data = data;
+    out.has_auxpow = (out.version() & BLOCK_VERSION_AUXPOW) != 0;
+    ByteReader reader(data + BLOCK_HEADER_SIZE, len - BLOCK_HEADER_SIZE);
+
+    if (out.has_auxpow) {
+        // Parent coinbase, parent block hash, coinbase and chain merkle
+        // branches, parent header
+        AuxPowView& aux = out.auxpow;
+        if (!parse_transaction(reader.position(), reader.remaining(), aux.coinbase) ||
+            !reader.skip(aux.coinbase.size) || !reader.skip(32) ||
+            !read_merkle_branch(reader, aux.coinbase_branch, aux.coinbase_depth, aux.coinbase_index) ||
+            !read_merkle_branch(reader, aux.chain_branch, aux.chain_depth, aux.chain_index) ||
+            !reader.read_span(BLOCK_HEADER_SIZE, aux.parent_header)) {
+            return false;
+        }
+    }
+
+    out.size = reader.position() - data;
+    header = out;
+    return true;
+}
+
+bool parse_block(const uint8_t* data, size_t len, BlockView& block) {
+    HeaderView header;
+    if (!parse_header(data, len, header)) {
+        return false;
+    }
+
+    BlockView out;
+    out.data = data;
+    out.size = len;
+    ByteReader reader(data + header.size, len - header.size);
+
+    if (!reader.read_varint(out.tx_count) || out.tx_count == 0 || out.tx_count > reader.remaining() / MIN_TX_SIZE) {
+        return false;
+    }
+    out.txs_offset = reader.position() - data;
+    block = out;
+    return true;
+}
+
+BlockScanner::BlockScanner(const AddressIndex& index) : index_(index) {
+}
+
+bool BlockScanner::scan_block(const uint8_t* data, size_t len, std::vector<BlockMatch>& matches,
+                              BlockScanStats* stats) const {
+    BlockScanStats local;
+    local.blocks = 1;
+    local.bytes = len;
+
+    BlockView block;
+    bool ok = parse_block(data, len, block);
+    bool have_block_hash = false;
+    uint8_t block_hash[32];
+
+    ByteReader reader(data + block.txs_offset, ok ? len - block.txs_offset : 0);
+    for (uint64_t t = 0; ok && t < block.tx_count; t++) {
+        TransactionView tx;
+        if (!parse_transaction(reader.position(), reader.remaining(), tx)) {
+            ok = false;
+            break;
+        }
+        reader.skip(tx.size);
+        local.transactions++;
+        local.outputs += tx.output_count;
+
+        bool have_txid = false;
+        uint8_t txid[32];
+        TxOutputReader outputs(tx);
+        TxOutputView output;
+        for (uint32_t vout = 0; outputs.next(output); vout++) {
+            const uint8_t* payload;
+            size_t payload_len;
+            ScriptType type = classify_script(output.script_pubkey, output.script_pubkey_len, payload, payload_len);
+
+            uint8_t key_hash[20];
+            const uint8_t* hash;
+            if (type == ScriptType::P2PKH) {
+                hash = payload;
+            } else if (type == ScriptType::P2PK) {
+                if (payload_len == 33) {
+                    hash160_fixed<33>(payload, key_hash);
+                } else {
+                    hash160_fixed<65>(payload, key_hash);
+                }
+                hash = key_hash;
+            } else {
+                continue;
+            }
+            if (!index_.contains(hash)) {
+                continue;
+            }
+
+            if (!have_txid) {
+                transaction_id(tx, txid);
+                have_txid = true;
+            }
+            if (!have_block_hash) {
+                sha256_double_fixed<80>(block.header(), block_hash);
+                have_block_hash = true;
+            }
+
+            BlockMatch match;
+            memcpy(match.block_hash, block_hash, 32);
+            memcpy(match.txid, txid, 32);
+            match.vout = vout;
+            match.value = output.value;
+            memcpy(match.pubkey_hash, hash, 20);
+            match.type = type;
+            matches.push_back(match);
+        }
+    }
+
+    if (!ok) {
+        local.bad_blocks = 1;
+    }
+    if (stats) {
+        stats->bytes += local.bytes;
+        stats->blocks += local.blocks;
+        stats->bad_blocks += local.bad_blocks;
+        stats->transactions += local.transactions;
+        stats->outputs += local.outputs;
+    }
+    return ok;
+}
+
+namespace {
+
+struct FramedBlock {
+    const uint8_t* data;
+    size_t len;
+    size_t file;
+};
+
+// State shared by the reader thread and the scanning thread
+struct ScanPipeline {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<FramedBlock> blocks; // framed by the reader, not yet taken
+    size_t bytes_ahead = 0;         // framed but not yet scanned
+    size_t done_files = 0;          // files that are fully scanned
+    bool reading = true;
+    bool ok = true;
+    uint64_t files = 0;
+};
+
+} // namespace
+
+// The reader may run this far ahead of the scan. Dogecoin blocks are at
+// most 1 MB, so the limit always admits at least a window of them.
+static const size_t MAX_BYTES_AHEAD = 64 * 1024 * 1024;
+static const size_t MIN_WINDOW = 64;
+static const size_t MAX_WINDOW = 1024;
+
+static void read_files(const std::vector<std::string>& paths, std::deque<MappedFile>& files,
+                       ScanPipeline& pipe) {
+    uint8_t magic[4];
+    bool have_magic = false;
+    bool ok = true;
+    size_t closed = 0;
+
+    for (size_t f = 0; ok && f < paths.size(); f++) {
+        files.emplace_back();
+        MappedFile& file = files.back();
+        if (!file.open(paths[f])) {
+            ok = false;
+            break;
+        }
+
+        const uint8_t* data = file.data();
+        size_t size = file.size();
+        size_t pos = 0;
+        while (pos + 8 <= size) {
+            const uint8_t* frame = data + pos;
+            // The node preallocates block files, so zeros mark the end
+            if (read_le32(frame) == 0) {
+                break;
+            }
+            if (!have_magic) {
+                memcpy(magic, frame, 4);
+                have_magic = true;
+            } else if (memcmp(magic, frame, 4) != 0) {
+                ok = false;
+                break;
+            }
+
+            size_t len = read_le32(frame + 4);
+            if (len > size - pos - 8) {
+                break; // a block the node was still writing
+            }
+
+            // Fault the block in here so the pool parses from memory
+            const volatile uint8_t* bytes = frame + 8;
+            for (size_t off = 0; off < len; off += 4096) {
+                (void)bytes[off];
+            }
+
+            std::unique_lock<std::mutex> lock(pipe.mutex);
+            pipe.blocks.push_back({frame + 8, len, f});
+            pipe.bytes_ahead += len;
+            // Wake the scan once per window rather than per block
+            if (pipe.blocks.size() == MIN_WINDOW || pipe.bytes_ahead > MAX_BYTES_AHEAD) {
+                pipe.cv.notify_all();
+            }
+            pipe.cv.wait(lock, [&] { return pipe.bytes_ahead <= MAX_BYTES_AHEAD; });
+
+            // Unmap files the scan has finished with
+            while (closed < pipe.done_files) {
+                files[closed++].close();
+            }
+            pos += 8 + len;
+        }
+
+        std::lock_guard<std::mutex> lock(pipe.mutex);
+        pipe.files++;
+    }
+
+    std::lock_guard<std::mutex> lock(pipe.mutex);
+    pipe.ok = ok;
+    pipe.reading = false;
+    pipe.cv.notify_all();
+}
+
+bool BlockScanner::scan_files(const std::vector<std::string>& paths, std::vector<BlockMatch>& matches,
+                              BlockScanStats* stats) const {
+    ScanPipeline pipe;
+    std::deque<MappedFile> files;
+    std::thread reader([&] { read_files(paths, files, pipe); });
+
+    std::vector<FramedBlock> window;
+    std::vector<std::vector<BlockMatch>> found;
+    std::vector<BlockScanStats> block_stats;
+    BlockScanStats total;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(pipe.mutex);
+            // A full window, or whatever is framed once the reader stops or
+            // is held back by oversized blocks
+            pipe.cv.wait(lock, [&] {
+                return !pipe.reading || pipe.blocks.size() >= MIN_WINDOW ||
+                       pipe.bytes_ahead > MAX_BYTES_AHEAD;
+            });
+            size_t n = pipe.blocks.size();
+            if (n == 0) {
+                break; // reading is over and every block is scanned
+            }
+            n = n < MAX_WINDOW ? n : MAX_WINDOW;
+            window.assign(pipe.blocks.begin(), pipe.blocks.begin() + n);
+            pipe.blocks.erase(pipe.blocks.begin(), pipe.blocks.begin() + n);
+        }
+
+        size_t n = window.size();
+        found.assign(n, std::vector<BlockMatch>());
+        block_stats.assign(n, BlockScanStats());
+        thread_pool().parallel_for(n, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                scan_block(window[i].data, window[i].len, found[i], &block_stats[i]);
+            }
+        });
+
+        size_t scanned = 0;
+        for (size_t i = 0; i < n; i++) {
+            matches.insert(matches.end(), found[i].begin(), found[i].end());
+            total.bytes += block_stats[i].bytes;
+            total.blocks += block_stats[i].blocks;
+            total.bad_blocks += block_stats[i].bad_blocks;
+            total.transactions += block_stats[i].transactions;
+            total.outputs += block_stats[i].outputs;
+            scanned += window[i].len;
+        }
+
+        std::lock_guard<std::mutex> lock(pipe.mutex);
+        pipe.bytes_ahead -= scanned;
+        // Blocks arrive in file order, so every earlier file is finished
+        pipe.done_files = window.back().file;
+        pipe.cv.notify_all();
+    }
+
+    reader.join();
+
+    if (stats) {
+        stats->files += pipe.files;
+        stats->bytes += total.bytes;
+        stats->blocks += total.blocks;
+        stats->bad_blocks += total.bad_blocks;
+        stats->transactions += total.transactions;
+        stats->outputs += total.outputs;
+    }
+    return pipe.ok;
+}
+
+} // namespace doge
@@ -0,0 +1,119 @@
+#ifndef DOGE_BLOCK_SCANNER_H
+#define DOGE_BLOCK_SCANNER_H
+
+#include "address_index.h"
+#include "script.h"
+#include "transaction_view.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace doge {
+
+const size_t BLOCK_HEADER_SIZE = 80;
+
+// Header version bit marking a merge-mined block, whose header is followed
+// by an AuxPoW proof (parent coinbase, merkle branches, parent header)
+const uint32_t BLOCK_VERSION_AUXPOW = 1 << 8;
+
+// AuxPoW proof of a merge-mined header, parsed in place. The parent chain's
+// block did the work: its coinbase commits to this block's hash through
+// the chain merkle branch, and sits in the parent block through the
+// coinbase branch.
+struct AuxPowView {
+    TransactionView coinbase;
+    const uint8_t* coinbase_branch = nullptr; // coinbase_depth * 32 bytes
+    size_t coinbase_depth = 0;
+    uint32_t coinbase_index = 0;
+    const uint8_t* chain_branch = nullptr; // chain_depth * 32 bytes
+    size_t chain_depth = 0;
+    uint32_t chain_index = 0;
+    const uint8_t* parent_header = nullptr; // BLOCK_HEADER_SIZE bytes
+};
+
+// A block header followed by its AuxPoW proof when the version has
+// BLOCK_VERSION_AUXPOW, as blocks and headers messages serialize it
+struct HeaderView {
+    const uint8_t* data = nullptr;
+    size_t size = 0; // header plus proof
+    bool has_auxpow = false;
+    AuxPowView auxpow;
+
+    uint32_t version() const { return read_le32(data); }
+    uint32_t bits() const { return read_le32(data + 72); }
+};
+
+bool parse_header(const uint8_t* data, size_t len, HeaderView& header);
+
+// A serialized block parsed in place, as TransactionView is for one
+// transaction. Transactions start at txs_offset and follow back to back.
+struct BlockView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    uint64_t tx_count = 0;
+    size_t txs_offset = 0;
+
+    const uint8_t* header() const { return data; }
+    uint32_t version() const;
+};
+
+// Locate the transactions of the block at data, skipping an AuxPoW proof
+// when the header has one. The transactions themselves are not parsed.
+bool parse_block(const uint8_t* data, size_t len, BlockView& block);
+
+// A watched output found in a block
+struct BlockMatch {
+    uint8_t block_hash[32]; // internal byte order
+    uint8_t txid[32];       // internal byte order
+    uint32_t vout;
+    uint64_t value;
+    uint8_t pubkey_hash[20];
+    ScriptType type; // P2PKH, or P2PK matched through the key's hash160
+};
+
+struct BlockScanStats {
+    uint64_t files = 0;
+    uint64_t bytes = 0;
+    uint64_t blocks = 0;
+    uint64_t bad_blocks = 0; // malformed or truncated, skipped
+    uint64_t transactions = 0;
+    uint64_t outputs = 0;
+};
+
+// Finds payments to watched addresses in raw blocks.
+//
+// Transactions are walked in place and every scriptPubKey is classified by
+// its template, so nothing is allocated per transaction or output. A txid
+// and block hash are computed only for transactions that pay a watched
+// address.
+//
+// scan_files() reads blk*.dat files (network magic + length + block, the
+// node's on-disk format) through a two-stage pipeline: a reader thread maps
+// each file, frames its blocks and faults their pages in, while the thread
+// pool parses the blocks already framed. The reader stays a bounded
+// distance ahead, so memory use does not grow with the amount scanned.
+class BlockScanner {
+public:
+    // index must outlive the scanner and not change during a scan
+    explicit BlockScanner(const AddressIndex& index);
+
+    // Scan one block. Matches are appended in block order. Returns false
+    // if the block is malformed; matches found before the fault are kept.
+    bool scan_block(const uint8_t* data, size_t len, std::vector<BlockMatch>& matches,
+                    BlockScanStats* stats = nullptr) const;
+
+    // Scan block files in order. Matches are appended in file order.
+    // Returns false if a file cannot be opened or mixes network magics;
+    // files before it are still scanned.
+    bool scan_files(const std::vector<std::string>& paths, std::vector<BlockMatch>& matches,
+                    BlockScanStats* stats = nullptr) const;
+
+private:
+    const AddressIndex& index_;
+};
+
+} // namespace doge
+
+#endif // DOGE_BLOCK_SCANNER_H
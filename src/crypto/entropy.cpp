@@ -0,0 +1,211 @@
+#include "entropy.h"
+#include <atomic>
+#include <cstring>
+#include <fstream>
+
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#elif defined(__APPLE__) && defined(__MACH__)
+#include <Security/Security.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define DOGE_HAVE_ATFORK 1
+#endif
+
+namespace doge {
+
+#ifdef SYS_getrandom
+// getrandom(2) through syscall(), since libc may predate the wrapper (old
+// glibc, Android < 28). Fails on kernels older than 3.17.
+static bool getrandom_bytes(uint8_t* out, size_t len) {
+    while (len > 0) {
+        long n = syscall(SYS_getrandom, out, len, 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        out += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+#endif
+
+bool os_random_bytes(uint8_t* out, size_t len) {
+#if defined(__APPLE__) && defined(__MACH__)
+    // Use SecRandomCopyBytes on iOS/macOS
+    return SecRandomCopyBytes(kSecRandomDefault, len, out) == errSecSuccess;
+#else
+#ifdef SYS_getrandom
+    if (getrandom_bytes(out, len)) {
+        return true;
+    }
+#endif
+    // Fall back to /dev/urandom (works on all Android API levels)
+    std::ifstream urandom("/dev/urandom", std::ios::binary);
+    return static_cast<bool>(urandom.read(reinterpret_cast<char*>(out), len));
+#endif
+}
+
+void secure_wipe(void* p, size_t len) {
+    volatile uint8_t* v = static_cast<volatile uint8_t*>(p);
+    while (len--) {
+        *v++ = 0;
+    }
+}
+
+// ChaCha20 block function (RFC 8439) with a zero nonce
+static inline uint32_t rotl32(uint32_t x, int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+#define CHACHA_QR(a, b, c, d) \
+    a += b; d ^= a; d = rotl32(d, 16); \
+    c += d; b ^= c; b = rotl32(b, 12); \
+    a += b; d ^= a; d = rotl32(d, 8);  \
+    c += d; b ^= c; b = rotl32(b, 7)
+
+static void chacha20_block(const uint32_t key[8], uint32_t counter, uint8_t out[64]) {
+    uint32_t in[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+        counter, 0, 0, 0
+    };
+    uint32_t x[16];
+    memcpy(x, in, sizeof(x));
+
+    for (int i = 0; i < 10; i++) {
+        CHACHA_QR(x[0], x[4], x[8], x[12]);
+        CHACHA_QR(x[1], x[5], x[9], x[13]);
+        CHACHA_QR(x[2], x[6], x[10], x[14]);
+        CHACHA_QR(x[3], x[7], x[11], x[15]);
+        CHACHA_QR(x[0], x[5], x[10], x[15]);
+        CHACHA_QR(x[1], x[6], x[11], x[12]);
+        CHACHA_QR(x[2], x[7], x[8], x[13]);
+        CHACHA_QR(x[3], x[4], x[9], x[14]);
+    }
+
+    for (int i = 0; i < 16; i++) {
+        uint32_t v = x[i] + in[i];
+        out[i * 4 + 0] = static_cast<uint8_t>(v);
+        out[i * 4 + 1] = static_cast<uint8_t>(v >> 8);
+        out[i * 4 + 2] = static_cast<uint8_t>(v >> 16);
+        out[i * 4 + 3] = static_cast<uint8_t>(v >> 24);
+    }
+    secure_wipe(x, sizeof(x));
+}
+
+#undef CHACHA_QR
+
+// Keystream generated per refill; the first 32 bytes become the next key
+static const size_t DRBG_BUFFER_SIZE = 16 * 64;
+static const uint64_t DRBG_RESEED_BYTES = 1 << 20;
+
+// Bumped in the child after fork() so every thread state there reseeds
+// instead of replaying the parent's stream
+static std::atomic<uint32_t> fork_generation(0);
+
+#ifdef DOGE_HAVE_ATFORK
+static void on_fork_child() {
+    fork_generation.fetch_add(1, std::memory_order_relaxed);
+}
+#endif
+
+static void register_fork_handler() {
+#ifdef DOGE_HAVE_ATFORK
+    static const bool registered = pthread_atfork(nullptr, nullptr, on_fork_child) == 0;
+    (void)registered;
+#endif
+}
+
+namespace {
+
+// Fast-key-erasure DRBG: each refill runs ChaCha20 under the current key,
+// replaces the key with the first block's leading bytes and hands out the
+// rest, wiping bytes as they are served. Earlier output cannot be
+// reconstructed from the state.
+struct Drbg {
+    uint32_t key[8];
+    uint8_t buffer[DRBG_BUFFER_SIZE];
+    size_t available = 0;            // Unserved bytes at the end of buffer
+    uint64_t since_seed = 0;
+    uint32_t generation = 0;
+    bool seeded = false;
+
+    ~Drbg() {
+        secure_wipe(key, sizeof(key));
+        secure_wipe(buffer, sizeof(buffer));
+    }
+
+    // Mix fresh OS entropy into the key
+    bool reseed() {
+        uint32_t fresh[8];
+        if (!os_random_bytes(reinterpret_cast<uint8_t*>(fresh), sizeof(fresh))) {
+            return false;
+        }
+        for (int i = 0; i < 8; i++) {
+            key[i] = seeded ? (key[i] ^ fresh[i]) : fresh[i];
+        }
+        secure_wipe(fresh, sizeof(fresh));
+
+        // Drop output buffered under the old key
+        secure_wipe(buffer, sizeof(buffer));
+        available = 0;
+        since_seed = 0;
+        generation = fork_generation.load(std::memory_order_relaxed);
+        seeded = true;
+        return true;
+    }
+
+    void refill() {
+        for (uint32_t i = 0; i < DRBG_BUFFER_SIZE / 64; i++) {
+            chacha20_block(key, i, buffer + i * 64);
+        }
+        memcpy(key, buffer, sizeof(key));
+        secure_wipe(buffer, sizeof(key));
+        available = DRBG_BUFFER_SIZE - sizeof(key);
+    }
+
+    bool generate(uint8_t* out, size_t len) {
+        bool forked = seeded && generation != fork_generation.load(std::memory_order_relaxed);
+        if (!seeded || forked || since_seed >= DRBG_RESEED_BYTES) {
+            if (!reseed()) {
+                // Only a periodic reseed may fail softly, keeping the
+                // current key; a fresh or forked state must not produce output
+                if (!seeded || forked) {
+                    return false;
+                }
+                since_seed = 0;
+            }
+        }
+
+        since_seed += len;
+        while (len > 0) {
+            if (available == 0) {
+                refill();
+            }
+            size_t n = len < available ? len : available;
+            uint8_t* src = buffer + DRBG_BUFFER_SIZE - available;
+            memcpy(out, src, n);
+            secure_wipe(src, n);
+            available -= n;
+            out += n;
+            len -= n;
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+bool random_bytes(uint8_t* out, size_t len) {
+    register_fork_handler();
+    thread_local Drbg drbg;
+    return drbg.generate(out, len);
+}
+
+} // namespace doge
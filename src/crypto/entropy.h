@@ -0,0 +1,24 @@
+#ifndef DOGE_ENTROPY_H
+#define DOGE_ENTROPY_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace doge {
+
+// Read len bytes straight from the OS CSPRNG: getrandom(2) with a
+// /dev/urandom fallback, or SecRandomCopyBytes on Apple platforms
+bool os_random_bytes(uint8_t* out, size_t len);
+
+// Fill out with len cryptographically secure random bytes. Served from a
+// per-thread ChaCha20 DRBG seeded from os_random_bytes(), reseeded every
+// 1 MiB of output and after fork(). Fails only if the OS source does.
+bool random_bytes(uint8_t* out, size_t len);
+
+// Zero len bytes at p in a way the optimizer cannot drop as a dead store
+// (for secrets going out of scope)
+void secure_wipe(void* p, size_t len);
+
+} // namespace doge
+
+#endif // DOGE_ENTROPY_H
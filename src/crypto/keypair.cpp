@@ -1,49 +1,24 @@
 #include "keypair.h"
 #include "base58.h"
-#include <secp256k1.h>
+#include "secp256k1_context.h"
+#include "entropy.h"
+#include "../utils/hash.h"
+#include "../utils/thread_pool.h"
+#include <atomic>
 #include <cstring>
-#include <random>
-#include <fstream>
-
-// For secure random number generation
-#ifdef __ANDROID__
-#include <sys/random.h>
-#elif defined(__APPLE__) && defined(__MACH__)
-#include <Security/Security.h>
-#endif
 
 namespace doge {
 
-static secp256k1_context* get_secp256k1_context() {
-    static secp256k1_context* ctx = nullptr;
-    if (!ctx) {
-        ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-    }
-    return ctx;
-}
-
 bool generate_private_key(std::vector<uint8_t>& private_key) {
     private_key.resize(32);
 
-#if defined(__APPLE__) && defined(__MACH__)
-    // Use SecRandomCopyBytes on iOS/macOS
-    if (SecRandomCopyBytes(kSecRandomDefault, 32, private_key.data()) != errSecSuccess) {
-        return false;
-    }
-#else
-    // Use /dev/urandom on Android and Linux (works on all API levels)
-    std::ifstream urandom("/dev/urandom", std::ios::binary);
-    if (!urandom.read(reinterpret_cast<char*>(private_key.data()), 32)) {
-        return false;
-    }
-#endif
-
-    // Verify the private key is valid
-    secp256k1_context* ctx = get_secp256k1_context();
-    if (!secp256k1_ec_seckey_verify(ctx, private_key.data())) {
-        // Invalid key, try again (very rare)
-        return generate_private_key(private_key);
-    }
+    // Redraw until the key is valid (a retry is very rare)
+    secp256k1_context* ctx = secp256k1_thread_context();
+    do {
+        if (!random_bytes(private_key.data(), 32)) {
+            return false;
+        }
+    } while (!secp256k1_ec_seckey_verify(ctx, private_key.data()));
 
     return true;
 }
@@ -55,7 +30,7 @@ bool derive_public_key(const std::vector<uint8_t>& private_key,
         return false;
     }
 
-    secp256k1_context* ctx = get_secp256k1_context();
+    secp256k1_context* ctx = secp256k1_thread_context();
 
     // Verify private key
     if (!secp256k1_ec_seckey_verify(ctx, private_key.data())) {
@@ -80,6 +55,51 @@ bool derive_public_key(const std::vector<uint8_t>& private_key,
     return true;
 }
 
+bool generate_keypairs(size_t count, bool compressed,
+                       uint8_t* private_keys, uint8_t* public_keys, uint8_t* pubkey_hashes) {
+    if (count == 0) {
+        return true;
+    }
+
+    // Entropy for the whole batch in one request
+    if (!random_bytes(private_keys, count * 32)) {
+        return false;
+    }
+
+    size_t pubkey_len = compressed ? 33 : 65;
+    unsigned int flags = compressed ? SECP256K1_EC_COMPRESSED : SECP256K1_EC_UNCOMPRESSED;
+    std::atomic<bool> ok(true);
+
+    thread_pool().parallel_for(count, 64, [&](size_t begin, size_t end) {
+        secp256k1_context* ctx = secp256k1_thread_context();
+
+        for (size_t i = begin; i < end; i++) {
+            uint8_t* key = private_keys + i * 32;
+
+            // Redraw just this key if it is out of range (very rare)
+            while (!secp256k1_ec_seckey_verify(ctx, key)) {
+                if (!random_bytes(key, 32)) {
+                    ok = false;
+                    return;
+                }
+            }
+
+            secp256k1_pubkey pubkey;
+            size_t output_len = pubkey_len;
+            if (!secp256k1_ec_pubkey_create(ctx, &pubkey, key) ||
+                !secp256k1_ec_pubkey_serialize(ctx, public_keys + i * pubkey_len, &output_len, &pubkey, flags)) {
+                ok = false;
+                return;
+            }
+        }
+
+        hash160_many(public_keys + begin * pubkey_len, pubkey_len, end - begin,
+                     pubkey_hashes + begin * 20);
+    });
+
+    return ok;
+}
+
 std::string private_key_to_wif(const std::vector<uint8_t>& private_key,
                                 bool compressed,
                                 bool mainnet) {
@@ -106,13 +126,10 @@ bool wif_to_private_key(const std::string& wif,
                         std::vector<uint8_t>& private_key,
                         bool& compressed,
                         bool& mainnet) {
-    std::vector<uint8_t> payload;
-    if (!base58check_decode(wif, payload)) {
-        return false;
-    }
-
-    // Check payload length (33 or 34 bytes)
-    if (payload.size() != 33 && payload.size() != 34) {
+    // Payload is 33 or 34 bytes
+    uint8_t payload[34];
+    size_t payload_len = base58check_decode_into(wif, payload, sizeof(payload));
+    if (payload_len != 33 && payload_len != 34) {
         return false;
     }
 
@@ -127,7 +144,7 @@ bool wif_to_private_key(const std::string& wif,
     }
 
     // Check if compressed
-    if (payload.size() == 34) {
+    if (payload_len == 34) {
         if (payload[33] != 0x01) {
             return false; // Invalid compression flag
         }
@@ -137,10 +154,10 @@ bool wif_to_private_key(const std::string& wif,
     }
 
     // Extract private key (32 bytes after version)
-    private_key.assign(payload.begin() + 1, payload.begin() + 33);
+    private_key.assign(payload + 1, payload + 33);
 
     // Verify the private key is valid
-    secp256k1_context* ctx = get_secp256k1_context();
+    secp256k1_context* ctx = secp256k1_thread_context();
     if (!secp256k1_ec_seckey_verify(ctx, private_key.data())) {
         return false;
     }
@@ -15,6 +15,13 @@ bool derive_public_key(const std::vector<uint8_t>& private_key,
                        std::vector<uint8_t>& public_key,
                        bool compressed = true);
 
+// Generate count keypairs at once, writing count * 32 private key bytes,
+// count * 33 (or 65) public key bytes and count * 20 hash160 bytes. Entropy
+// is drawn for the whole batch in one call and derivation is spread over
+// the thread pool.
+bool generate_keypairs(size_t count, bool compressed,
+                       uint8_t* private_keys, uint8_t* public_keys, uint8_t* pubkey_hashes);
+
 // Convert private key to WIF (Wallet Import Format)
 // mainnet: version 0x9e, testnet: version 0xf1
 std::string private_key_to_wif(const std::vector<uint8_t>& private_key,
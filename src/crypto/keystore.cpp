@@ -0,0 +1,321 @@
+#include "keystore.h"
+#include "entropy.h"
+#include "keypair.h"
+#include "secp256k1_context.h"
+#include "../utils/hash.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace doge {
+
+struct KeystoreHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t record_count;
+    uint32_t record_size;
+    uint32_t reserved0;
+    uint8_t reserved[32];
+};
+static_assert(sizeof(KeystoreHeader) == 64, "keystore header must stay 64 bytes");
+
+static const char KEYSTORE_MAGIC[8] = {'D', 'O', 'G', 'E', 'K', 'E', 'Y', 'S'};
+static const uint32_t KEYSTORE_VERSION = 1;
+static const uint32_t KEYSTORE_BYTE_ORDER = 0x01020304;
+
+// Sorted index entry: pubkey_hash followed by a little-endian record index
+static const size_t INDEX_ENTRY_SIZE = 24;
+
+static size_t file_size_for(size_t count) {
+    return sizeof(KeystoreHeader) + count * (sizeof(KeystoreRecord) + INDEX_ENTRY_SIZE);
+}
+
+// Fill in everything but the secret's validity, which the caller checked
+static bool derive_record(const uint8_t* private_key, bool compressed, bool mainnet, KeystoreRecord& out) {
+    secp256k1_context* ctx = secp256k1_thread_context();
+    secp256k1_pubkey pubkey;
+    if (!secp256k1_ec_pubkey_create(ctx, &pubkey, private_key)) {
+        return false;
+    }
+
+    size_t len = 33;
+    secp256k1_ec_pubkey_serialize(ctx, out.public_key, &len, &pubkey, SECP256K1_EC_COMPRESSED);
+    if (compressed) {
+        hash160(out.public_key, 33, out.pubkey_hash);
+    } else {
+        uint8_t full[65];
+        len = 65;
+        secp256k1_ec_pubkey_serialize(ctx, full, &len, &pubkey, SECP256K1_EC_UNCOMPRESSED);
+        hash160(full, 65, out.pubkey_hash);
+    }
+
+    memcpy(out.private_key, private_key, 32);
+    out.flags = (compressed ? KEYSTORE_COMPRESSED : 0) | (mainnet ? KEYSTORE_MAINNET : 0);
+    memset(out.reserved, 0, sizeof(out.reserved));
+    return true;
+}
+
+size_t keystore_public_key(const KeystoreRecord& record, uint8_t* out) {
+    if (record.compressed()) {
+        memcpy(out, record.public_key, 33);
+        return 33;
+    }
+
+    secp256k1_context* ctx = secp256k1_thread_context();
+    secp256k1_pubkey pubkey;
+    size_t len = 65;
+    if (!secp256k1_ec_pubkey_parse(ctx, &pubkey, record.public_key, 33) ||
+        !secp256k1_ec_pubkey_serialize(ctx, out, &len, &pubkey, SECP256K1_EC_UNCOMPRESSED)) {
+        return 0;
+    }
+    return len;
+}
+
+Keystore::~Keystore() {
+    close();
+}
+
+void Keystore::close() {
+    if (!pending_.empty()) {
+        secure_wipe(pending_.data(), pending_.size() * sizeof(KeystoreRecord));
+    }
+    std::vector<KeystoreRecord>().swap(pending_);
+    pending_index_.clear();
+
+    file_.close();
+    records_ = nullptr;
+    sorted_ = nullptr;
+    mapped_count_ = 0;
+}
+
+// Record count of a mapped keystore file, or false if it is not one
+static bool check_file(const MappedFile& file, size_t& count) {
+    if (file.size() < sizeof(KeystoreHeader)) {
+        return false;
+    }
+
+    KeystoreHeader header;
+    memcpy(&header, file.data(), sizeof(header));
+    if (memcmp(header.magic, KEYSTORE_MAGIC, sizeof(KEYSTORE_MAGIC)) != 0 || header.version != KEYSTORE_VERSION ||
+        header.byte_order != KEYSTORE_BYTE_ORDER || header.record_size != sizeof(KeystoreRecord)) {
+        return false;
+    }
+
+    // The count is checked against the file before any pointer is formed
+    if (header.record_count > file.size() / (sizeof(KeystoreRecord) + INDEX_ENTRY_SIZE) ||
+        file_size_for(static_cast<size_t>(header.record_count)) != file.size()) {
+        return false;
+    }
+
+    count = static_cast<size_t>(header.record_count);
+    return true;
+}
+
+void Keystore::adopt(MappedFile& file, size_t count) {
+    file_.swap(file);
+    mapped_count_ = count;
+    records_ = reinterpret_cast<const KeystoreRecord*>(file_.data() + sizeof(KeystoreHeader));
+    sorted_ = file_.data() + sizeof(KeystoreHeader) + count * sizeof(KeystoreRecord);
+}
+
+bool Keystore::open(const std::string& path) {
+    MappedFile file;
+    size_t count;
+    if (!file.open(path, true) || !check_file(file, count)) {
+        return false;
+    }
+
+    close();
+    adopt(file, count);
+    return true;
+}
+
+const KeystoreRecord* Keystore::record(size_t index) const {
+    if (index < mapped_count_) {
+        return records_ + index;
+    }
+    index -= mapped_count_;
+    return index < pending_.size() ? &pending_[index] : nullptr;
+}
+
+bool Keystore::find(const uint8_t* pubkey_hash, size_t& index) const {
+    size_t lo = 0;
+    size_t hi = mapped_count_;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        const uint8_t* entry = sorted_ + mid * INDEX_ENTRY_SIZE;
+        int cmp = memcmp(entry, pubkey_hash, 20);
+        if (cmp == 0) {
+            uint32_t i = static_cast<uint32_t>(entry[20]) | (static_cast<uint32_t>(entry[21]) << 8) |
+                         (static_cast<uint32_t>(entry[22]) << 16) | (static_cast<uint32_t>(entry[23]) << 24);
+            if (i >= mapped_count_) {
+                return false;
+            }
+            index = i;
+            return true;
+        }
+        if (cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    std::array<uint8_t, 20> key;
+    memcpy(key.data(), pubkey_hash, 20);
+    auto it = pending_index_.find(key);
+    if (it == pending_index_.end()) {
+        return false;
+    }
+    index = it->second;
+    return true;
+}
+
+void Keystore::insert(const KeystoreRecord& record, size_t& index, bool& added) {
+    added = false;
+    if (find(record.pubkey_hash, index)) {
+        return;
+    }
+
+    index = size();
+    std::array<uint8_t, 20> key;
+    memcpy(key.data(), record.pubkey_hash, 20);
+
+    // Growing the vector would leave unwiped copies of secrets behind
+    if (pending_.size() == pending_.capacity()) {
+        std::vector<KeystoreRecord> grown;
+        grown.reserve(pending_.empty() ? 64 : pending_.size() * 2);
+        grown.assign(pending_.begin(), pending_.end());
+        if (!pending_.empty()) {
+            secure_wipe(pending_.data(), pending_.size() * sizeof(KeystoreRecord));
+        }
+        pending_.swap(grown);
+    }
+    pending_.push_back(record);
+    pending_index_[key] = index;
+    added = true;
+}
+
+bool Keystore::add(const uint8_t* private_key, bool compressed, bool mainnet, size_t& index) {
+    if (!secp256k1_ec_seckey_verify(secp256k1_thread_context(), private_key)) {
+        return false;
+    }
+
+    KeystoreRecord record;
+    bool ok = derive_record(private_key, compressed, mainnet, record);
+    if (ok) {
+        bool added;
+        insert(record, index, added);
+    }
+    secure_wipe(&record, sizeof(record));
+    return ok;
+}
+
+size_t Keystore::add_wifs(const std::string* wifs, size_t count, size_t* indices) {
+    std::vector<KeystoreRecord> records(count);
+    std::vector<uint8_t> valid(count, 0);
+
+    thread_pool().parallel_for(count, 64, [&](size_t begin, size_t end) {
+        std::vector<uint8_t> private_key;
+        bool compressed;
+        bool mainnet;
+        for (size_t i = begin; i < end; i++) {
+            if (wif_to_private_key(wifs[i], private_key, compressed, mainnet)) {
+                valid[i] = derive_record(private_key.data(), compressed, mainnet, records[i]) ? 1 : 0;
+                secure_wipe(private_key.data(), private_key.size());
+            }
+        }
+    });
+
+    size_t added_count = 0;
+    for (size_t i = 0; i < count; i++) {
+        indices[i] = SIZE_MAX;
+        if (valid[i]) {
+            bool added;
+            insert(records[i], indices[i], added);
+            added_count += added ? 1 : 0;
+        }
+    }
+
+    if (count > 0) {
+        secure_wipe(records.data(), count * sizeof(KeystoreRecord));
+    }
+    return added_count;
+}
+
+bool Keystore::save(const std::string& path) {
+    size_t count = size();
+    if (count > UINT32_MAX) {
+        return false;
+    }
+
+    std::vector<uint8_t> sorted(count * INDEX_ENTRY_SIZE);
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return memcmp(record(a)->pubkey_hash, record(b)->pubkey_hash, 20) < 0;
+    });
+    for (size_t i = 0; i < count; i++) {
+        uint8_t* entry = sorted.data() + i * INDEX_ENTRY_SIZE;
+        memcpy(entry, record(order[i])->pubkey_hash, 20);
+        for (int b = 0; b < 4; b++) {
+            entry[20 + b] = static_cast<uint8_t>(order[i] >> (8 * b));
+        }
+    }
+
+    KeystoreHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, KEYSTORE_MAGIC, sizeof(KEYSTORE_MAGIC));
+    header.version = KEYSTORE_VERSION;
+    header.byte_order = KEYSTORE_BYTE_ORDER;
+    header.record_count = count;
+    header.record_size = sizeof(KeystoreRecord);
+
+    std::string tmp_path = path + ".tmp";
+    FILE* f = create_private_file(tmp_path);
+    if (!f) {
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    if (ok && mapped_count_ > 0) {
+        ok = fwrite(records_, sizeof(KeystoreRecord), mapped_count_, f) == mapped_count_;
+    }
+    if (ok && !pending_.empty()) {
+        ok = fwrite(pending_.data(), sizeof(KeystoreRecord), pending_.size(), f) == pending_.size();
+    }
+    if (ok && count > 0) {
+        ok = fwrite(sorted.data(), 1, sorted.size(), f) == sorted.size();
+    }
+    if (!sync_and_close(f) || !ok) {
+        remove(tmp_path.c_str());
+        return false;
+    }
+
+    // Windows cannot replace a file that is still mapped, so let go of the
+    // old mapping first. Every record is in the new file by now.
+    MappedFile old;
+    old.swap(file_);
+    old.close();
+
+    // If the rename fails the keys stay mapped from the temporary file,
+    // which is left in place for recovery
+    bool replaced = replace_file(tmp_path, path);
+    MappedFile saved;
+    size_t saved_count;
+    if (!saved.open(replaced ? path : tmp_path, true) || !check_file(saved, saved_count) || saved_count != count) {
+        close();
+        return false;
+    }
+
+    close();
+    adopt(saved, saved_count);
+    return replaced;
+}
+
+} // namespace doge
@@ -0,0 +1,92 @@
+#ifndef DOGE_KEYSTORE_H
+#define DOGE_KEYSTORE_H
+
+#include "../utils/mapped_file.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace doge {
+
+const uint8_t KEYSTORE_COMPRESSED = 0x01;
+const uint8_t KEYSTORE_MAINNET = 0x02;
+
+// One key as stored on disk. Everything derived from the secret is cached,
+// so loading a key is a copy rather than an EC multiplication.
+struct KeystoreRecord {
+    uint8_t private_key[32];
+    uint8_t public_key[33];   // always compressed, whatever the flags say
+    uint8_t pubkey_hash[20];  // of the key in the form its address uses
+    uint8_t flags;
+    uint8_t reserved[10];
+
+    bool compressed() const { return (flags & KEYSTORE_COMPRESSED) != 0; }
+    bool mainnet() const { return (flags & KEYSTORE_MAINNET) != 0; }
+};
+static_assert(sizeof(KeystoreRecord) == 96, "keystore records are 96 bytes on disk");
+
+// The record's public key in the form its address uses (33 or 65 bytes
+// into out). Returns the length, or 0 if the stored key is corrupt.
+size_t keystore_public_key(const KeystoreRecord& record, uint8_t* out);
+
+// Fixed-record key file: a 64-byte versioned header, the records, then
+// (pubkey_hash, record index) pairs sorted by hash. open() maps the file and
+// checks only the header, so a wallet of any size opens in constant time;
+// each record page is read from disk when a key on it is first used, and a
+// hash lookup is a binary search over the sorted pairs.
+//
+// Keys added after open() are held in memory until save(). The file holds
+// unencrypted secrets, like the WIF strings it replaces.
+class Keystore {
+public:
+    Keystore() = default;
+    ~Keystore();
+
+    Keystore(const Keystore&) = delete;
+    Keystore& operator=(const Keystore&) = delete;
+
+    // On failure the current contents are kept
+    bool open(const std::string& path);
+    void close();
+
+    size_t size() const { return mapped_count_ + pending_.size(); }
+
+    // Valid until the next add, open, save or close
+    const KeystoreRecord* record(size_t index) const;
+
+    bool find(const uint8_t* pubkey_hash, size_t& index) const;
+
+    // Validate and append a secret, returning its index. A key already in
+    // the store keeps its index.
+    bool add(const uint8_t* private_key, bool compressed, bool mainnet, size_t& index);
+
+    // Decode and add count WIF strings, deriving public keys on the thread
+    // pool. indices[i] is set to the key's index, or SIZE_MAX if wifs[i] is
+    // invalid. Returns the number of keys newly added.
+    size_t add_wifs(const std::string* wifs, size_t count, size_t* indices);
+
+    // Write every key to path (via a temporary file and rename) and map the
+    // result in place of the current contents. If the rename fails, the
+    // keys stay mapped from path + ".tmp".
+    bool save(const std::string& path);
+
+private:
+    void insert(const KeystoreRecord& record, size_t& index, bool& added);
+    void adopt(MappedFile& file, size_t count);
+
+    MappedFile file_;
+    const KeystoreRecord* records_ = nullptr;
+    const uint8_t* sorted_ = nullptr;
+    size_t mapped_count_ = 0;
+
+    std::vector<KeystoreRecord> pending_;
+    std::map<std::array<uint8_t, 20>, size_t> pending_index_;
+};
+
+} // namespace doge
+
+#endif // DOGE_KEYSTORE_H
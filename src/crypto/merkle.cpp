@@ -0,0 +1,138 @@
+#include "merkle.h"
+#include "../utils/hash.h"
+#include "../utils/thread_pool.h"
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace doge {
+
+// Proofs per pool chunk: enough that each level batch fills the SIMD lanes
+static const size_t MERKLE_PROOF_CHUNK = 256;
+
+// An index needs depth bits, and a 32-bit index allows 2^32 leaves
+static const size_t MAX_MERKLE_DEPTH = 32;
+
+bool compute_merkle_root(const uint8_t* txids, size_t count, uint8_t* root, bool* mutated) {
+    if (count == 0) {
+        return false;
+    }
+
+    std::vector<uint8_t> level(txids, txids + count * 32);
+    std::vector<uint8_t> next;
+    bool mutation = false;
+
+    for (size_t n = count; n > 1; n = (n + 1) / 2) {
+        for (size_t i = 0; i + 1 < n; i += 2) {
+            if (memcmp(&level[i * 32], &level[(i + 1) * 32], 32) == 0) {
+                mutation = true;
+            }
+        }
+        if (n & 1) {
+            level.resize((n + 1) * 32);
+            memcpy(&level[n * 32], &level[(n - 1) * 32], 32);
+        }
+
+        // Every pair of the level is already a contiguous 64-byte message
+        next.resize((n + 1) / 2 * 32);
+        sha256_double_many(level.data(), 64, (n + 1) / 2, next.data());
+        level.swap(next);
+    }
+
+    memcpy(root, level.data(), 32);
+    if (mutated) {
+        *mutated = mutation;
+    }
+    return true;
+}
+
+static bool merkle_index_fits(size_t depth, uint32_t index) {
+    return depth <= MAX_MERKLE_DEPTH && (depth == MAX_MERKLE_DEPTH || (index >> depth) == 0);
+}
+
+// Place node and its sibling in hash order for level i of the path
+static void merkle_pair(const uint8_t* node, const uint8_t* sibling, bool right, uint8_t* pair) {
+    memcpy(pair + (right ? 32 : 0), node, 32);
+    memcpy(pair + (right ? 0 : 32), sibling, 32);
+}
+
+bool merkle_branch_root(const uint8_t* leaf, const uint8_t* branch, size_t depth, uint32_t index, uint8_t* root) {
+    if (!merkle_index_fits(depth, index)) {
+        return false;
+    }
+
+    uint8_t pair[64];
+    memcpy(root, leaf, 32);
+    for (size_t i = 0; i < depth; i++) {
+        merkle_pair(root, branch + i * 32, (index >> i) & 1, pair);
+        sha256_double_fixed<64>(pair, root);
+    }
+    return true;
+}
+
+bool verify_merkle_proof(const uint8_t* leaf, const uint8_t* branch, size_t depth, uint32_t index,
+                         const uint8_t* root) {
+    uint8_t node[32];
+    return merkle_branch_root(leaf, branch, depth, index, node) && memcmp(node, root, 32) == 0;
+}
+
+size_t verify_merkle_proofs(const MerkleProof* proofs, size_t count, uint8_t* results) {
+    std::atomic<size_t> valid(0);
+
+    thread_pool().parallel_for(count, MERKLE_PROOF_CHUNK, [&](size_t begin, size_t end) {
+        size_t n = end - begin;
+        std::vector<uint8_t> nodes(n * 32);
+        std::vector<size_t> active;
+        std::vector<uint8_t> pairs;
+        std::vector<uint8_t> hashes;
+        size_t local = 0;
+
+        for (size_t p = begin; p < end; p++) {
+            results[p] = 0;
+            if (merkle_index_fits(proofs[p].depth, proofs[p].index)) {
+                memcpy(&nodes[(p - begin) * 32], proofs[p].leaf, 32);
+                active.push_back(p);
+            }
+        }
+
+        // Climb every proof one level per pass, hashing the pass as a batch
+        for (size_t level = 0;; level++) {
+            size_t m = 0;
+            for (size_t k = 0; k < active.size(); k++) {
+                const MerkleProof& proof = proofs[active[k]];
+                const uint8_t* node = &nodes[(active[k] - begin) * 32];
+                if (level == proof.depth) {
+                    if (memcmp(node, proof.root, 32) == 0) {
+                        results[active[k]] = 1;
+                        local++;
+                    }
+                    continue;
+                }
+                active[m++] = active[k];
+            }
+            active.resize(m);
+            if (m == 0) {
+                break;
+            }
+
+            pairs.resize(m * 64);
+            hashes.resize(m * 32);
+            for (size_t k = 0; k < m; k++) {
+                const MerkleProof& proof = proofs[active[k]];
+                merkle_pair(&nodes[(active[k] - begin) * 32], proof.branch + level * 32,
+                            (proof.index >> level) & 1, &pairs[k * 64]);
+            }
+            sha256_double_many(pairs.data(), 64, m, hashes.data());
+            for (size_t k = 0; k < m; k++) {
+                memcpy(&nodes[(active[k] - begin) * 32], &hashes[k * 32], 32);
+            }
+        }
+
+        valid += local;
+    });
+
+    return valid.load();
+}
+
+} // namespace doge
@@ -0,0 +1,47 @@
+#ifndef DOGE_MERKLE_H
+#define DOGE_MERKLE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace doge {
+
+// Hashes here are in internal byte order (as sha256_double writes them),
+// the reverse of the hex that explorers and RPC display.
+
+// Merkle root of `count` txids stored back to back, as in a block header.
+// A level with an odd number of nodes pairs the last one with itself. Each
+// level is hashed as one sha256_double_many batch, so the SIMD lanes hash
+// several pairs at once. If mutated is given, it is set when some level
+// pairs two equal nodes: a second txid list with the same root exists
+// (CVE-2012-2459), so such a block must not be trusted by its root alone.
+// Returns false if count is 0.
+bool compute_merkle_root(const uint8_t* txids, size_t count, uint8_t* root, bool* mutated = nullptr);
+
+// Check that leaf sits at position index of the tree with the given root.
+// branch holds depth sibling hashes from the leaf level up, as in an
+// AuxPoW proof or a BIP37 partial tree walk; bit i of index tells whether
+// the node at level i is a right child.
+bool verify_merkle_proof(const uint8_t* leaf, const uint8_t* branch, size_t depth, uint32_t index,
+                         const uint8_t* root);
+
+// Root reached by hashing leaf up through branch as verify_merkle_proof
+// does. Returns false if index does not fit depth bits.
+bool merkle_branch_root(const uint8_t* leaf, const uint8_t* branch, size_t depth, uint32_t index, uint8_t* root);
+
+struct MerkleProof {
+    const uint8_t* leaf;   // 32 bytes
+    const uint8_t* branch; // depth * 32 bytes
+    size_t depth;
+    uint32_t index;
+    const uint8_t* root;   // 32 bytes
+};
+
+// Verify many proofs, writing 1 (valid) or 0 to results[i]. Proofs are split
+// across the thread pool, and within a chunk the same level of every proof
+// is hashed as one batch. Returns the number of valid proofs.
+size_t verify_merkle_proofs(const MerkleProof* proofs, size_t count, uint8_t* results);
+
+} // namespace doge
+
+#endif // DOGE_MERKLE_H
@@ -1,84 +1,88 @@
 #include "message_signer.h"
 #include "address.h"
 #include "../utils/hash.h"
-#include <secp256k1.h>
+#include "secp256k1_context.h"
+#include "serialize.h"
+#include "verify_cache.h"
+#include "../utils/thread_pool.h"
 #include <secp256k1_recovery.h>
 #include <cstring>
 #include <sstream>
 
 namespace doge {
 
-static secp256k1_context* get_secp256k1_context() {
-    static secp256k1_context* ctx = nullptr;
-    if (!ctx) {
-        ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-    }
-    return ctx;
-}
-
-// Encode varint (variable-length integer)
-static void encode_varint(size_t value, std::vector<uint8_t>& out) {
-    if (value < 0xfd) {
-        out.push_back(static_cast<uint8_t>(value));
-    } else if (value <= 0xffff) {
-        out.push_back(0xfd);
-        out.push_back(static_cast<uint8_t>(value & 0xff));
-        out.push_back(static_cast<uint8_t>((value >> 8) & 0xff));
-    } else if (value <= 0xffffffff) {
-        out.push_back(0xfe);
-        out.push_back(static_cast<uint8_t>(value & 0xff));
-        out.push_back(static_cast<uint8_t>((value >> 8) & 0xff));
-        out.push_back(static_cast<uint8_t>((value >> 16) & 0xff));
-        out.push_back(static_cast<uint8_t>((value >> 24) & 0xff));
-    } else {
-        out.push_back(0xff);
-        for (int i = 0; i < 8; i++) {
-            out.push_back(static_cast<uint8_t>((value >> (i * 8)) & 0xff));
-        }
-    }
+// Magic string - \031 is octal for 25, the length of "Dogecoin Signed Message:\n"
+static const char* MESSAGE_MAGIC = "\031Dogecoin Signed Message:\n";
+static const size_t MESSAGE_MAGIC_LEN = 26; // 1 byte length prefix + 25 byte string = 26 total
+
+// Envelope: magic + varint(msg_len) + message, hashed in place
+static void begin_envelope(Sha256Ctx& ctx, uint64_t message_len) {
+    ctx.update(reinterpret_cast<const uint8_t*>(MESSAGE_MAGIC), MESSAGE_MAGIC_LEN);
+
+    uint8_t varint[9];
+    size_t varint_len = encode_varint(message_len, varint);
+    ctx.update(varint, varint_len);
 }
 
-// Construct Dogecoin message format for signing
-static void construct_bitcoin_message(const std::string& message, std::vector<uint8_t>& out) {
-    // Magic string - \031 is octal for 25, the length of "Dogecoin Signed Message:\n"
-    const char* magic = "\031Dogecoin Signed Message:\n";
-    size_t magic_len = 26; // 1 byte length prefix + 25 byte string = 26 total
+MessageHasher::MessageHasher(uint64_t message_len) {
+    begin_envelope(ctx_, message_len);
+}
 
-    // Message bytes
-    const uint8_t* msg_data = reinterpret_cast<const uint8_t*>(message.data());
-    size_t msg_len = message.size();
+void MessageHasher::update(const uint8_t* data, size_t len) {
+    ctx_.update(data, len);
+}
 
-    // Build: magic + varint(msg_len) + message
-    out.clear();
-    out.insert(out.end(), magic, magic + magic_len);
+void MessageHasher::final(uint8_t* hash) {
+    uint8_t first[32];
+    ctx_.final(first);
+    sha256_fixed<32>(first, hash);
+}
 
-    std::vector<uint8_t> varint;
-    encode_varint(msg_len, varint);
-    out.insert(out.end(), varint.begin(), varint.end());
+void message_hash(const uint8_t* message, size_t len, uint8_t* hash) {
+    MessageHasher hasher(len);
+    hasher.update(message, len);
+    hasher.final(hash);
+}
+
+void message_hash_batch(const std::string* messages, size_t count, uint8_t* hashes) {
+    // The inner SHA-256 covers the whole envelope and runs per message;
+    // the outer one always takes 32 bytes, so it goes through the
+    // multi-lane kernels a group at a time
+    const size_t GROUP = 64;
+    uint8_t inner[GROUP * 32];
+
+    for (size_t base = 0; base < count; base += GROUP) {
+        size_t n = count - base < GROUP ? count - base : GROUP;
+
+        for (size_t i = 0; i < n; i++) {
+            const std::string& message = messages[base + i];
+            Sha256Ctx ctx;
+            begin_envelope(ctx, message.size());
+            ctx.update(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+            ctx.final(inner + i * 32);
+        }
 
-    out.insert(out.end(), msg_data, msg_data + msg_len);
+        sha256_many(inner, 32, n, hashes + base * 32);
+    }
 }
 
-std::string sign_message(const std::string& message,
-                         const std::vector<uint8_t>& private_key,
-                         bool compressed) {
+std::string sign_message_hash(const uint8_t* hash,
+                              const std::vector<uint8_t>& private_key,
+                              bool compressed) {
     if (private_key.size() != 32) {
         return "";
     }
+    return sign_message_hash(hash, private_key.data(), compressed);
+}
 
-    // Construct Bitcoin message format
-    std::vector<uint8_t> full_message;
-    construct_bitcoin_message(message, full_message);
-
-    // Double SHA256 hash
-    uint8_t hash[32];
-    sha256_double(full_message.data(), full_message.size(), hash);
-
+std::string sign_message_hash(const uint8_t* hash,
+                              const uint8_t* private_key,
+                              bool compressed) {
     // Sign with secp256k1 (recoverable signature)
-    secp256k1_context* ctx = get_secp256k1_context();
+    secp256k1_context* ctx = secp256k1_thread_context();
     secp256k1_ecdsa_recoverable_signature sig;
 
-    if (!secp256k1_ecdsa_sign_recoverable(ctx, &sig, hash, private_key.data(), nullptr, nullptr)) {
+    if (!secp256k1_ecdsa_sign_recoverable(ctx, &sig, hash, private_key, nullptr, nullptr)) {
         return "";
     }
 
@@ -89,48 +93,51 @@ std::string sign_message(const std::string& message,
 
     // Build final signature (65 bytes)
     // First byte: 27 + recovery_id + (4 if compressed)
-    std::vector<uint8_t> signature(65);
+    uint8_t signature[65];
     signature[0] = 27 + recovery_id + (compressed ? 4 : 0);
-    memcpy(signature.data() + 1, compact_sig, 64);
+    memcpy(signature + 1, compact_sig, 64);
 
-    return base64_encode(signature);
+    return base64_encode(signature, sizeof(signature));
 }
 
-bool verify_message(const std::string& message,
-                    const std::string& signature_base64,
-                    const std::string& address) {
-    // Decode signature
-    std::vector<uint8_t> signature;
-    if (!base64_decode(signature_base64, signature)) {
-        return false;
-    }
+std::string sign_message(const uint8_t* message, size_t len,
+                         const std::vector<uint8_t>& private_key,
+                         bool compressed) {
+    uint8_t hash[32];
+    message_hash(message, len, hash);
+    return sign_message_hash(hash, private_key, compressed);
+}
 
-    if (signature.size() != 65) {
-        return false;
-    }
+std::string sign_message(const std::string& message,
+                         const std::vector<uint8_t>& private_key,
+                         bool compressed) {
+    return sign_message(reinterpret_cast<const uint8_t*>(message.data()), message.size(),
+                        private_key, compressed);
+}
 
+// hash160 of the public key recovered from a 65-byte compact signature
+// (header byte + r + s) over hash, served from the verify cache when enabled
+static bool recover_pubkey_hash(const uint8_t* hash, const uint8_t* signature, uint8_t* pubkey_hash) {
     // Extract recovery_id and compressed flag from first byte
     uint8_t header = signature[0];
     if (header < 27 || header >= 27 + 8) {
         return false;
     }
 
+    VerifyCache& cache = verify_cache();
+    bool use_cache = cache.enabled();
+    if (use_cache && cache.lookup(hash, signature, pubkey_hash)) {
+        return true;
+    }
+
     int recovery_id = (header - 27) & 3;
     bool compressed = (header - 27) >= 4;
 
-    // Construct Bitcoin message format
-    std::vector<uint8_t> full_message;
-    construct_bitcoin_message(message, full_message);
-
-    // Double SHA256 hash
-    uint8_t hash[32];
-    sha256_double(full_message.data(), full_message.size(), hash);
-
     // Parse recoverable signature
-    secp256k1_context* ctx = get_secp256k1_context();
+    secp256k1_context* ctx = secp256k1_thread_context();
     secp256k1_ecdsa_recoverable_signature sig;
 
-    if (!secp256k1_ecdsa_recoverable_signature_parse_compact(ctx, &sig, signature.data() + 1, recovery_id)) {
+    if (!secp256k1_ecdsa_recoverable_signature_parse_compact(ctx, &sig, signature + 1, recovery_id)) {
         return false;
     }
 
@@ -141,19 +148,96 @@ bool verify_message(const std::string& message,
     }
 
     // Serialize public key
-    std::vector<uint8_t> pubkey_bytes(compressed ? 33 : 65);
-    size_t pubkey_len = pubkey_bytes.size();
+    uint8_t pubkey_bytes[65];
+    size_t pubkey_len = compressed ? 33 : 65;
     unsigned int flags = compressed ? SECP256K1_EC_COMPRESSED : SECP256K1_EC_UNCOMPRESSED;
 
-    if (!secp256k1_ec_pubkey_serialize(ctx, pubkey_bytes.data(), &pubkey_len, &pubkey, flags)) {
+    if (!secp256k1_ec_pubkey_serialize(ctx, pubkey_bytes, &pubkey_len, &pubkey, flags)) {
         return false;
     }
 
-    // Generate address from recovered public key
-    std::string recovered_address = public_key_to_address(pubkey_bytes, true);
+    hash160(pubkey_bytes, pubkey_len, pubkey_hash);
 
-    // Compare addresses
-    return recovered_address == address;
+    if (use_cache) {
+        cache.insert(hash, signature, pubkey_hash);
+    }
+    return true;
+}
+
+bool verify_message_hash(const uint8_t* hash,
+                         const std::string& signature_base64,
+                         const ParsedAddress& address) {
+    // Decode signature
+    std::vector<uint8_t> signature;
+    if (!base64_decode(signature_base64, signature)) {
+        return false;
+    }
+
+    if (signature.size() != 65) {
+        return false;
+    }
+
+    uint8_t pubkey_hash[20];
+    if (!recover_pubkey_hash(hash, signature.data(), pubkey_hash)) {
+        return false;
+    }
+
+    // The version byte only selects the network; the signer is the hash
+    return memcmp(pubkey_hash, address.hash, 20) == 0;
+}
+
+bool verify_message_hash(const uint8_t* hash,
+                         const std::string& signature_base64,
+                         const std::string& address) {
+    ParsedAddress parsed;
+    if (!parse_address(address, parsed)) {
+        return false;
+    }
+    return verify_message_hash(hash, signature_base64, parsed);
+}
+
+bool verify_message(const uint8_t* message, size_t len,
+                    const std::string& signature_base64,
+                    const std::string& address) {
+    uint8_t hash[32];
+    message_hash(message, len, hash);
+    return verify_message_hash(hash, signature_base64, address);
+}
+
+bool verify_message(const uint8_t* message, size_t len,
+                    const std::string& signature_base64,
+                    const ParsedAddress& address) {
+    uint8_t hash[32];
+    message_hash(message, len, hash);
+    return verify_message_hash(hash, signature_base64, address);
+}
+
+bool verify_message(const std::string& message,
+                    const std::string& signature_base64,
+                    const std::string& address) {
+    return verify_message(reinterpret_cast<const uint8_t*>(message.data()), message.size(),
+                          signature_base64, address);
+}
+
+void verify_messages(size_t count,
+                     const std::string* messages,
+                     const std::string* signatures,
+                     const std::string* addresses,
+                     uint8_t* results) {
+    thread_pool().parallel_for(count, 16, [&](size_t begin, size_t end) {
+        const size_t GROUP = 64;
+        uint8_t digests[GROUP * 32];
+
+        for (size_t base = begin; base < end; base += GROUP) {
+            size_t n = end - base < GROUP ? end - base : GROUP;
+            message_hash_batch(messages + base, n, digests);
+
+            for (size_t i = 0; i < n; i++) {
+                results[base + i] = verify_message_hash(digests + i * 32, signatures[base + i],
+                                                        addresses[base + i]) ? 1 : 0;
+            }
+        }
+    });
 }
 
 // Base64 encoding/decoding
@@ -1,23 +1,83 @@
 #ifndef DOGE_MESSAGE_SIGNER_H
 #define DOGE_MESSAGE_SIGNER_H
 
+#include "address.h"
+#include "../utils/hash.h"
 #include <string>
 #include <vector>
 #include <cstdint>
 
 namespace doge {
 
+// Digest of the signed-message envelope:
+// SHA256(SHA256("\x19Dogecoin Signed Message:\n" + varint(len) + message))
+void message_hash(const uint8_t* message, size_t len, uint8_t* hash);
+
+// Streaming form of message_hash for messages read in chunks (files,
+// replays). The total length is part of the envelope, so it is needed up front.
+class MessageHasher {
+public:
+    explicit MessageHasher(uint64_t message_len);
+
+    void update(const uint8_t* data, size_t len);
+    void final(uint8_t* hash); // writes 32 bytes
+
+private:
+    Sha256Ctx ctx_;
+};
+
+// message_hash of count messages, writing count * 32 bytes. The outer
+// SHA-256 pass runs through the multi-lane kernels.
+void message_hash_batch(const std::string* messages, size_t count, uint8_t* hashes);
+
 // Sign a message using Bitcoin message signing format
 // Returns base64-encoded signature (65 bytes: recovery_id + r + s)
 std::string sign_message(const std::string& message,
                          const std::vector<uint8_t>& private_key,
                          bool compressed = true);
+std::string sign_message(const uint8_t* message, size_t len,
+                         const std::vector<uint8_t>& private_key,
+                         bool compressed = true);
+
+// Sign a digest produced by message_hash / MessageHasher
+std::string sign_message_hash(const uint8_t* hash,
+                              const std::vector<uint8_t>& private_key,
+                              bool compressed = true);
+std::string sign_message_hash(const uint8_t* hash,
+                              const uint8_t* private_key, // 32 bytes, already validated
+                              bool compressed = true);
 
 // Verify a message signature
 // Returns true if signature is valid for the given message and address
 bool verify_message(const std::string& message,
                     const std::string& signature_base64,
                     const std::string& address);
+bool verify_message(const uint8_t* message, size_t len,
+                    const std::string& signature_base64,
+                    const std::string& address);
+
+// As above against an address parsed once with parse_address: the
+// recovered key's hash160 is compared directly, for mainnet and testnet
+bool verify_message(const uint8_t* message, size_t len,
+                    const std::string& signature_base64,
+                    const ParsedAddress& address);
+
+// Verify a signature over a digest produced by message_hash / MessageHasher
+bool verify_message_hash(const uint8_t* hash,
+                         const std::string& signature_base64,
+                         const std::string& address);
+bool verify_message_hash(const uint8_t* hash,
+                         const std::string& signature_base64,
+                         const ParsedAddress& address);
+
+// Verify count (message, signature, address) triples at once, writing 1
+// (valid) or 0 per item to results. The outer SHA-256 pass runs through the
+// multi-lane kernels and key recovery is spread over the thread pool.
+void verify_messages(size_t count,
+                     const std::string* messages,
+                     const std::string* signatures,
+                     const std::string* addresses,
+                     uint8_t* results);
 
 // Base64 encoding/decoding helpers
 std::string base64_encode(const uint8_t* data, size_t len);
@@ -0,0 +1,206 @@
+#include "pow.h"
+#include "merkle.h"
+#include "serialize.h"
+#include "../utils/hash.h"
+#include "../utils/scrypt.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace doge {
+
+// Headers per scrypt batch: enough to fill the widest backend's lanes and
+// keep the pool's per-chunk overhead negligible next to ~100 us per hash
+static const size_t POW_BATCH = 16;
+
+// Marks the chain merkle root in a parent coinbase script
+static const uint8_t MERGED_MINING_HEADER[4] = {0xfa, 0xbe, 'm', 'm'};
+
+bool compact_to_target(uint32_t bits, uint8_t* target) {
+    memset(target, 0, 32);
+
+    uint32_t size = bits >> 24;
+    uint32_t mantissa = bits & 0x007fffff;
+    if (mantissa == 0 || (bits & 0x00800000)) {
+        return false;
+    }
+    if (size > 34 || (mantissa > 0xff && size > 33) || (mantissa > 0xffff && size > 32)) {
+        return false;
+    }
+
+    if (size <= 3) {
+        mantissa >>= 8 * (3 - size);
+        if (mantissa == 0) {
+            return false;
+        }
+        size = 3;
+    }
+    // Mantissa bytes land at size - 3 .. size - 1; any above 31 are zero
+    for (uint32_t i = 0; i < 3; i++) {
+        uint32_t pos = size - 3 + i;
+        if (pos < 32) {
+            target[pos] = static_cast<uint8_t>(mantissa >> (8 * i));
+        }
+    }
+    return true;
+}
+
+// a <= b for little-endian 256-bit numbers
+static bool le256_at_most(const uint8_t* a, const uint8_t* b) {
+    for (int i = 31; i >= 0; i--) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i];
+        }
+    }
+    return true;
+}
+
+bool check_proof_of_work(const uint8_t* pow_hash, uint32_t bits) {
+    uint8_t target[32];
+    if (!compact_to_target(bits, target)) {
+        return false;
+    }
+
+    static uint8_t limit[32];
+    static const bool have_limit = compact_to_target(POW_LIMIT_BITS, limit);
+    if (!have_limit || !le256_at_most(target, limit)) {
+        return false;
+    }
+    return le256_at_most(pow_hash, target);
+}
+
+void header_pow_hash(const uint8_t* header, uint8_t* hash) {
+    scrypt_1024_1_1(header, BLOCK_HEADER_SIZE, hash);
+}
+
+// Slot of this chain in a chain merkle tree of the given height, derived
+// from the nonce the parent coinbase commits to
+static uint32_t auxpow_expected_index(uint32_t nonce, size_t height) {
+    uint32_t rand = nonce;
+    rand = rand * 1103515245 + 12345;
+    rand += AUXPOW_CHAIN_ID;
+    rand = rand * 1103515245 + 12345;
+    return rand % (1u << height);
+}
+
+bool check_auxpow(const AuxPowView& auxpow, const uint8_t* child_hash) {
+    if (auxpow.coinbase_index != 0 || auxpow.chain_depth > AUXPOW_MAX_CHAIN_DEPTH) {
+        return false;
+    }
+
+    // The coinbase is the parent block's first transaction
+    uint8_t coinbase_txid[32];
+    transaction_id(auxpow.coinbase, coinbase_txid);
+    if (!verify_merkle_proof(coinbase_txid, auxpow.coinbase_branch, auxpow.coinbase_depth, 0,
+                             auxpow.parent_header + 36)) {
+        return false;
+    }
+
+    // and commits to the root of a tree holding the child hash
+    uint8_t chain_root[32];
+    if (!merkle_branch_root(child_hash, auxpow.chain_branch, auxpow.chain_depth, auxpow.chain_index, chain_root)) {
+        return false;
+    }
+    std::reverse(chain_root, chain_root + 32);
+
+    TxInputReader inputs(auxpow.coinbase);
+    TxInputView input;
+    if (!inputs.next(input)) {
+        return false;
+    }
+    const uint8_t* script = input.script_sig;
+    const uint8_t* script_end = script + input.script_sig_len;
+
+    const uint8_t* head = std::search(script, script_end, MERGED_MINING_HEADER, MERGED_MINING_HEADER + 4);
+    const uint8_t* root = std::search(script, script_end, chain_root, chain_root + 32);
+    if (root == script_end) {
+        return false;
+    }
+    if (head != script_end) {
+        // Exactly one marker, directly before the root
+        if (std::search(head + 1, script_end, MERGED_MINING_HEADER, MERGED_MINING_HEADER + 4) != script_end ||
+            head + 4 != root) {
+            return false;
+        }
+    } else if (root - script > 20) {
+        // Without a marker the root must start within the first 20 bytes
+        return false;
+    }
+
+    // Tree size and nonce follow the root
+    const uint8_t* tail = root + 32;
+    if (script_end - tail < 8) {
+        return false;
+    }
+    return read_le32(tail) == (1u << auxpow.chain_depth) &&
+           auxpow.chain_index == auxpow_expected_index(read_le32(tail + 4), auxpow.chain_depth);
+}
+
+// The rest of check_header_pow once pow_hash, the scrypt hash of the
+// header that did the work, is known
+static bool check_header_work(const HeaderView& header, const uint8_t* pow_hash) {
+    if (!check_proof_of_work(pow_hash, header.bits())) {
+        return false;
+    }
+    if (!header.has_auxpow) {
+        return true;
+    }
+
+    uint8_t child_hash[32];
+    sha256_double_fixed<80>(header.data, child_hash);
+    return check_auxpow(header.auxpow, child_hash);
+}
+
+// Header whose scrypt hash carries the work
+static const uint8_t* work_header(const HeaderView& header) {
+    return header.has_auxpow ? header.auxpow.parent_header : header.data;
+}
+
+bool check_header_pow(const HeaderView& header) {
+    uint8_t pow_hash[32];
+    header_pow_hash(work_header(header), pow_hash);
+    return check_header_work(header, pow_hash);
+}
+
+bool verify_headers_pow(const uint8_t* data, size_t len, std::vector<uint8_t>& results, bool tx_counts) {
+    // Framing is sequential but cheap next to scrypt
+    std::vector<HeaderView> headers;
+    ByteReader reader(data, len);
+    bool framed = true;
+    while (reader.remaining() > 0) {
+        HeaderView header;
+        uint64_t tx_count;
+        if (!parse_header(reader.position(), reader.remaining(), header) || !reader.skip(header.size) ||
+            (tx_counts && !reader.read_varint(tx_count))) {
+            framed = false;
+            break;
+        }
+        headers.push_back(header);
+    }
+
+    size_t count = headers.size();
+    results.assign(count, 0);
+    uint8_t* out = results.data();
+
+    thread_pool().parallel_for(count, POW_BATCH, [&](size_t begin, size_t end) {
+        uint8_t work[POW_BATCH * BLOCK_HEADER_SIZE];
+        uint8_t hashes[POW_BATCH * 32];
+
+        for (size_t i = begin; i < end; i += POW_BATCH) {
+            size_t n = end - i < POW_BATCH ? end - i : POW_BATCH;
+            for (size_t k = 0; k < n; k++) {
+                memcpy(work + k * BLOCK_HEADER_SIZE, work_header(headers[i + k]), BLOCK_HEADER_SIZE);
+            }
+            scrypt_1024_1_1_many(work, BLOCK_HEADER_SIZE, n, hashes);
+
+            for (size_t k = 0; k < n; k++) {
+                out[i + k] = check_header_work(headers[i + k], hashes + k * 32) ? 1 : 0;
+            }
+        }
+    });
+
+    return framed;
+}
+
+} // namespace doge
@@ -0,0 +1,58 @@
+#ifndef DOGE_POW_H
+#define DOGE_POW_H
+
+#include "block_scanner.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace doge {
+
+// Easiest target the network accepts, in compact form (main and testnet)
+const uint32_t POW_LIMIT_BITS = 0x1e0fffff;
+
+// Dogecoin's merged-mining chain ID, which places its hash in the parent
+// coinbase's chain merkle tree
+const uint32_t AUXPOW_CHAIN_ID = 0x62;
+
+// Longest chain merkle branch the node accepts
+const size_t AUXPOW_MAX_CHAIN_DEPTH = 30;
+
+// Expand compact nBits into a 256-bit little-endian target. Returns false
+// if the encoding is negative, zero or overflows 256 bits.
+bool compact_to_target(uint32_t bits, uint8_t* target);
+
+// True if pow_hash (little-endian, as scrypt writes it) is at or below the
+// target encoded by bits, and that target is within POW_LIMIT_BITS
+bool check_proof_of_work(const uint8_t* pow_hash, uint32_t bits);
+
+// scrypt PoW hash of an 80-byte header
+void header_pow_hash(const uint8_t* header, uint8_t* hash);
+
+// Check that an AuxPoW proof commits its parent block to the child block
+// whose double-SHA256 hash is child_hash: the coinbase is the parent
+// block's first transaction, and its first input script carries the chain
+// merkle root at the slot for AUXPOW_CHAIN_ID, as the node checks it.
+// Work is not checked here. Chain ID rules that depend on the network
+// (strict child IDs, parents claiming our ID) are left to the caller.
+bool check_auxpow(const AuxPowView& auxpow, const uint8_t* child_hash);
+
+// Check the work of one header: its own scrypt hash against its nBits or,
+// for a merge-mined header, the parent header's scrypt hash against the
+// child's nBits plus check_auxpow()
+bool check_header_pow(const HeaderView& header);
+
+// Check the PoW of headers serialized back to back, each followed by its
+// AuxPoW proof when it has one. With tx_counts, each header is also
+// followed by a transaction count, as in a headers message (whose leading
+// count the caller strips). results gets 1 (valid) or 0 per header.
+// Headers are split across the thread pool; each thread reuses one scrypt
+// scratchpad. Returns false if the data cannot be framed into headers;
+// results then covers only the headers before the fault.
+bool verify_headers_pow(const uint8_t* data, size_t len, std::vector<uint8_t>& results,
+                        bool tx_counts = false);
+
+} // namespace doge
+
+#endif // DOGE_POW_H
@@ -0,0 +1,84 @@
+#include "script.h"
+
+#include <cstring>
+
+namespace doge {
+
+static const uint8_t OP_RETURN = 0x6a;
+static const uint8_t OP_DUP = 0x76;
+static const uint8_t OP_EQUAL = 0x87;
+static const uint8_t OP_EQUALVERIFY = 0x88;
+static const uint8_t OP_HASH160 = 0xa9;
+static const uint8_t OP_CHECKSIG = 0xac;
+static const uint8_t OP_CHECKMULTISIG = 0xae;
+static const uint8_t OP_1 = 0x51;
+static const uint8_t OP_16 = 0x60;
+
+void p2pkh_script(const uint8_t* pubkey_hash, uint8_t* out) {
+    out[0] = OP_DUP;
+    out[1] = OP_HASH160;
+    out[2] = 0x14; // push 20 bytes
+    memcpy(out + 3, pubkey_hash, 20);
+    out[23] = OP_EQUALVERIFY;
+    out[24] = OP_CHECKSIG;
+}
+
+const uint8_t* p2pkh_script_hash(const uint8_t* script, size_t len) {
+    if (len != P2PKH_SCRIPT_SIZE || script[0] != OP_DUP || script[1] != OP_HASH160 || script[2] != 0x14 ||
+        script[23] != OP_EQUALVERIFY || script[24] != OP_CHECKSIG) {
+        return nullptr;
+    }
+    return script + 3;
+}
+
+// Key pushes of a bare multisig script: m, then 33 or 65-byte pushes, then n
+static bool is_multisig(const uint8_t* script, size_t len) {
+    if (len < 3 || script[len - 1] != OP_CHECKMULTISIG || script[0] < OP_1 || script[0] > OP_16 ||
+        script[len - 2] < OP_1 || script[len - 2] > OP_16) {
+        return false;
+    }
+
+    size_t keys = 0;
+    size_t pos = 1;
+    while (pos < len - 2) {
+        uint8_t push = script[pos];
+        if ((push != 33 && push != 65) || pos + 1 + push > len - 2) {
+            return false;
+        }
+        pos += 1 + push;
+        keys++;
+    }
+    size_t m = script[0] - OP_1 + 1;
+    size_t n = script[len - 2] - OP_1 + 1;
+    return keys == n && m <= n;
+}
+
+ScriptType classify_script(const uint8_t* script, size_t len, const uint8_t*& payload, size_t& payload_len) {
+    payload = nullptr;
+    payload_len = 0;
+
+    if (const uint8_t* hash = p2pkh_script_hash(script, len)) {
+        payload = hash;
+        payload_len = 20;
+        return ScriptType::P2PKH;
+    }
+    if (len == 23 && script[0] == OP_HASH160 && script[1] == 0x14 && script[22] == OP_EQUAL) {
+        payload = script + 2;
+        payload_len = 20;
+        return ScriptType::P2SH;
+    }
+    if ((len == 35 || len == 67) && script[0] == len - 2 && script[len - 1] == OP_CHECKSIG) {
+        payload = script + 1;
+        payload_len = len - 2;
+        return ScriptType::P2PK;
+    }
+    if (len > 0 && script[0] == OP_RETURN) {
+        return ScriptType::NULL_DATA;
+    }
+    if (is_multisig(script, len)) {
+        return ScriptType::MULTISIG;
+    }
+    return ScriptType::NONSTANDARD;
+}
+
+} // namespace doge
@@ -0,0 +1,32 @@
+#ifndef DOGE_SCRIPT_H
+#define DOGE_SCRIPT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace doge {
+
+// OP_DUP OP_HASH160 <20-byte hash> OP_EQUALVERIFY OP_CHECKSIG
+const size_t P2PKH_SCRIPT_SIZE = 25;
+void p2pkh_script(const uint8_t* pubkey_hash, uint8_t* out);
+
+// Returns the pubkey hash inside a P2PKH script, or nullptr for any other script
+const uint8_t* p2pkh_script_hash(const uint8_t* script, size_t len);
+
+enum class ScriptType : uint8_t {
+    NONSTANDARD,
+    P2PK,      // <33 or 65-byte pubkey> OP_CHECKSIG
+    P2PKH,     // OP_DUP OP_HASH160 <20> OP_EQUALVERIFY OP_CHECKSIG
+    P2SH,      // OP_HASH160 <20> OP_EQUAL
+    MULTISIG,  // OP_m <pubkeys...> OP_n OP_CHECKMULTISIG
+    NULL_DATA, // OP_RETURN ...
+};
+
+// Match a scriptPubKey against the standard templates by length and opcode
+// bytes alone. payload points into script: the public key for P2PK, the
+// 20-byte hash for P2PKH and P2SH, and nullptr otherwise.
+ScriptType classify_script(const uint8_t* script, size_t len, const uint8_t*& payload, size_t& payload_len);
+
+} // namespace doge
+
+#endif // DOGE_SCRIPT_H
@@ -0,0 +1,50 @@
+#include "secp256k1_context.h"
+#include "entropy.h"
+#include <cstring>
+
+namespace doge {
+
+// Re-seed the context's blinding; left unblinded if no entropy is available
+static void randomize_context(secp256k1_context* ctx) {
+    uint8_t seed[32];
+    if (random_bytes(seed, sizeof(seed))) {
+        secp256k1_context_randomize(ctx, seed);
+    }
+    memset(seed, 0, sizeof(seed));
+}
+
+// Built once (thread-safe static init) and only ever read afterwards, which
+// is what makes concurrent clones safe
+static const secp256k1_context* master_context() {
+    static const secp256k1_context* master = [] {
+        secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+        randomize_context(ctx);
+        return ctx;
+    }();
+    return master;
+}
+
+namespace {
+
+struct ThreadContext {
+    secp256k1_context* ctx = nullptr;
+
+    ~ThreadContext() {
+        if (ctx) {
+            secp256k1_context_destroy(ctx);
+        }
+    }
+};
+
+} // namespace
+
+secp256k1_context* secp256k1_thread_context() {
+    thread_local ThreadContext local;
+    if (!local.ctx) {
+        local.ctx = secp256k1_context_clone(master_context());
+        randomize_context(local.ctx);
+    }
+    return local.ctx;
+}
+
+} // namespace doge
@@ -0,0 +1,16 @@
+#ifndef DOGE_SECP256K1_CONTEXT_H
+#define DOGE_SECP256K1_CONTEXT_H
+
+#include <secp256k1.h>
+
+namespace doge {
+
+// secp256k1 context for the calling thread. The first call on each thread
+// clones a shared master context (created once) and randomizes the clone
+// with its own seed for side-channel blinding. The result is owned by the
+// thread and destroyed when it exits; never hand it to another thread.
+secp256k1_context* secp256k1_thread_context();
+
+} // namespace doge
+
+#endif // DOGE_SECP256K1_CONTEXT_H
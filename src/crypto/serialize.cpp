@@ -0,0 +1,41 @@
+#include "serialize.h"
+
+namespace doge {
+
+size_t encode_varint(uint64_t value, uint8_t* out) {
+    if (value < 0xfd) {
+        out[0] = static_cast<uint8_t>(value);
+        return 1;
+    }
+
+    size_t width;
+    if (value <= 0xffff) {
+        out[0] = 0xfd;
+        width = 2;
+    } else if (value <= 0xffffffff) {
+        out[0] = 0xfe;
+        width = 4;
+    } else {
+        out[0] = 0xff;
+        width = 8;
+    }
+
+    for (size_t i = 0; i < width; i++) {
+        out[1 + i] = static_cast<uint8_t>((value >> (i * 8)) & 0xff);
+    }
+    return 1 + width;
+}
+
+void write_le32(uint32_t value, uint8_t* out) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+void write_le64(uint64_t value, uint8_t* out) {
+    for (int i = 0; i < 8; i++) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+} // namespace doge
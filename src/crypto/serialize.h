@@ -0,0 +1,115 @@
+#ifndef DOGE_SERIALIZE_H
+#define DOGE_SERIALIZE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace doge {
+
+// Bitcoin-style compact size (varint) of value into out, returning its
+// size (1, 3, 5 or 9 bytes)
+size_t encode_varint(uint64_t value, uint8_t* out);
+
+// Little-endian fixed-width fields of the wire format
+void write_le32(uint32_t value, uint8_t* out);
+void write_le64(uint64_t value, uint8_t* out);
+
+inline uint32_t read_le32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Bounds-checked cursor over serialized data. Every read fails, without
+// moving, if it would run past the end; nothing is copied, and spans point
+// into the original buffer.
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t len) : pos_(data), end_(data + len) {}
+
+    const uint8_t* position() const { return pos_; }
+    size_t remaining() const { return static_cast<size_t>(end_ - pos_); }
+
+    bool skip(size_t len) {
+        if (len > remaining()) {
+            return false;
+        }
+        pos_ += len;
+        return true;
+    }
+
+    bool read_span(size_t len, const uint8_t*& out) {
+        out = pos_;
+        return skip(len);
+    }
+
+    bool read_le32(uint32_t& value) {
+        if (remaining() < 4) {
+            return false;
+        }
+        value = doge::read_le32(pos_);
+        pos_ += 4;
+        return true;
+    }
+
+    bool read_le64(uint64_t& value) {
+        if (remaining() < 8) {
+            return false;
+        }
+        value = static_cast<uint64_t>(doge::read_le32(pos_)) |
+                (static_cast<uint64_t>(doge::read_le32(pos_ + 4)) << 32);
+        pos_ += 8;
+        return true;
+    }
+
+    // Inverse of encode_varint. Non-canonical encodings are rejected, as
+    // the node does.
+    bool read_varint(uint64_t& value) {
+        if (pos_ == end_) {
+            return false;
+        }
+        uint8_t tag = pos_[0];
+        if (tag < 0xfd) {
+            value = tag;
+            pos_++;
+            return true;
+        }
+
+        size_t width = tag == 0xfd ? 2 : tag == 0xfe ? 4 : 8;
+        if (remaining() < 1 + width) {
+            return false;
+        }
+        uint64_t v = 0;
+        for (size_t i = 0; i < width; i++) {
+            v |= static_cast<uint64_t>(pos_[1 + i]) << (8 * i);
+        }
+        uint64_t min = tag == 0xfd ? 0xfd : tag == 0xfe ? 0x10000 : 0x100000000ULL;
+        if (v < min) {
+            return false;
+        }
+        value = v;
+        pos_ += 1 + width;
+        return true;
+    }
+
+    // A varint length followed by that many bytes
+    bool read_var_span(const uint8_t*& out, size_t& len) {
+        const uint8_t* start = pos_;
+        uint64_t n;
+        if (!read_varint(n) || n > remaining()) {
+            pos_ = start;
+            return false;
+        }
+        len = static_cast<size_t>(n);
+        out = pos_;
+        pos_ += len;
+        return true;
+    }
+
+private:
+    const uint8_t* pos_;
+    const uint8_t* end_;
+};
+
+} // namespace doge
+
+#endif // DOGE_SERIALIZE_H
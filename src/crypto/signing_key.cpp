@@ -0,0 +1,139 @@
+#include "signing_key.h"
+#include "address.h"
+#include "entropy.h"
+#include "keypair.h"
+#include "message_signer.h"
+#include "secp256k1_context.h"
+#include "../utils/hash.h"
+#include "../utils/thread_pool.h"
+#include <cstring>
+
+namespace doge {
+
+SigningKey::~SigningKey() {
+    clear();
+}
+
+void SigningKey::clear() {
+    secure_wipe(secret_, sizeof(secret_));
+    valid_ = false;
+}
+
+bool SigningKey::set_private_key(const uint8_t* private_key, bool compressed, bool mainnet) {
+    clear();
+
+    secp256k1_context* ctx = secp256k1_thread_context();
+    if (!secp256k1_ec_seckey_verify(ctx, private_key)) {
+        return false;
+    }
+
+    secp256k1_pubkey pubkey;
+    if (!secp256k1_ec_pubkey_create(ctx, &pubkey, private_key)) {
+        return false;
+    }
+
+    size_t pubkey_len = compressed ? 33 : 65;
+    unsigned int flags = compressed ? SECP256K1_EC_COMPRESSED : SECP256K1_EC_UNCOMPRESSED;
+    if (!secp256k1_ec_pubkey_serialize(ctx, public_key_, &pubkey_len, &pubkey, flags)) {
+        return false;
+    }
+
+    finish(private_key, compressed, mainnet);
+    return true;
+}
+
+bool SigningKey::set_private_key(const uint8_t* private_key, const uint8_t* compressed_public_key,
+                                 bool compressed, bool mainnet) {
+    clear();
+
+    secp256k1_context* ctx = secp256k1_thread_context();
+    if (!secp256k1_ec_seckey_verify(ctx, private_key)) {
+        return false;
+    }
+
+    if (compressed) {
+        memcpy(public_key_, compressed_public_key, 33);
+    } else {
+        // Decompressing is a square root, far cheaper than a multiplication
+        secp256k1_pubkey pubkey;
+        size_t pubkey_len = 65;
+        if (!secp256k1_ec_pubkey_parse(ctx, &pubkey, compressed_public_key, 33) ||
+            !secp256k1_ec_pubkey_serialize(ctx, public_key_, &pubkey_len, &pubkey, SECP256K1_EC_UNCOMPRESSED)) {
+            return false;
+        }
+    }
+
+    finish(private_key, compressed, mainnet);
+    return true;
+}
+
+void SigningKey::finish(const uint8_t* private_key, bool compressed, bool mainnet) {
+    hash160(public_key_, compressed ? 33 : 65, pubkey_hash_);
+
+    ParsedAddress address;
+    address.version = mainnet ? ADDRESS_VERSION_MAINNET : ADDRESS_VERSION_TESTNET;
+    memcpy(address.hash, pubkey_hash_, 20);
+    address_ = format_address(address);
+
+    memcpy(secret_, private_key, 32);
+    compressed_ = compressed;
+    mainnet_ = mainnet;
+    valid_ = true;
+}
+
+bool SigningKey::set_wif(const std::string& wif) {
+    std::vector<uint8_t> private_key;
+    bool compressed;
+    bool mainnet;
+
+    clear();
+    if (!wif_to_private_key(wif, private_key, compressed, mainnet)) {
+        return false;
+    }
+
+    bool ok = set_private_key(private_key.data(), compressed, mainnet);
+    secure_wipe(private_key.data(), private_key.size());
+    return ok;
+}
+
+std::string SigningKey::wif() const {
+    if (!valid_) {
+        return "";
+    }
+
+    std::vector<uint8_t> private_key(secret_, secret_ + 32);
+    std::string result = private_key_to_wif(private_key, compressed_, mainnet_);
+    secure_wipe(private_key.data(), private_key.size());
+    return result;
+}
+
+std::string SigningKey::sign_hash(const uint8_t* hash) const {
+    if (!valid_) {
+        return "";
+    }
+    return sign_message_hash(hash, secret_, compressed_);
+}
+
+std::string SigningKey::sign(const uint8_t* message, size_t len) const {
+    uint8_t hash[32];
+    message_hash(message, len, hash);
+    return sign_hash(hash);
+}
+
+void SigningKey::sign_batch(const std::string* messages, size_t count, std::string* signatures) const {
+    thread_pool().parallel_for(count, 16, [&](size_t begin, size_t end) {
+        const size_t GROUP = 64;
+        uint8_t digests[GROUP * 32];
+
+        for (size_t base = begin; base < end; base += GROUP) {
+            size_t n = end - base < GROUP ? end - base : GROUP;
+            message_hash_batch(messages + base, n, digests);
+
+            for (size_t i = 0; i < n; i++) {
+                signatures[base + i] = sign_hash(digests + i * 32);
+            }
+        }
+    });
+}
+
+} // namespace doge
@@ -0,0 +1,66 @@
+#ifndef DOGE_SIGNING_KEY_H
+#define DOGE_SIGNING_KEY_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace doge {
+
+// A private key validated once, together with everything derived from it
+// (public key, hash160, address, WIF), for callers that sign repeatedly
+// with the same key. The secret is wiped on destruction.
+class SigningKey {
+public:
+    SigningKey() = default;
+    ~SigningKey();
+
+    SigningKey(const SigningKey&) = delete;
+    SigningKey& operator=(const SigningKey&) = delete;
+
+    // Load a 32-byte secret or a WIF string. On failure the key is left
+    // invalid.
+    bool set_private_key(const uint8_t* private_key, bool compressed = true, bool mainnet = true);
+    bool set_wif(const std::string& wif);
+
+    // As set_private_key, for a secret whose compressed public key is
+    // already known (from a keystore record), skipping the EC multiplication.
+    // The public key is trusted to belong to the secret.
+    bool set_private_key(const uint8_t* private_key, const uint8_t* compressed_public_key,
+                         bool compressed, bool mainnet);
+
+    bool is_valid() const { return valid_; }
+    bool is_compressed() const { return compressed_; }
+    bool is_mainnet() const { return mainnet_; }
+
+    const uint8_t* private_key() const { return secret_; }
+    const uint8_t* public_key() const { return public_key_; }
+    size_t public_key_size() const { return compressed_ ? 33 : 65; }
+    const uint8_t* pubkey_hash() const { return pubkey_hash_; }
+    const std::string& address() const { return address_; }
+    std::string wif() const;
+
+    // Signed-message signatures (base64), as sign_message; empty on failure
+    std::string sign(const uint8_t* message, size_t len) const;
+    std::string sign_hash(const uint8_t* hash) const;
+
+    // Sign count messages, hashing them in batches and spreading the
+    // signing over the thread pool
+    void sign_batch(const std::string* messages, size_t count, std::string* signatures) const;
+
+private:
+    void clear();
+    void finish(const uint8_t* private_key, bool compressed, bool mainnet);
+
+    uint8_t secret_[32] = {};
+    uint8_t public_key_[65] = {};
+    uint8_t pubkey_hash_[20] = {};
+    std::string address_;
+    bool compressed_ = true;
+    bool mainnet_ = true;
+    bool valid_ = false;
+};
+
+} // namespace doge
+
+#endif // DOGE_SIGNING_KEY_H
@@ -0,0 +1,263 @@
+#include "transaction.h"
+#include "secp256k1_context.h"
+#include "serialize.h"
+#include "../utils/thread_pool.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace doge {
+
+static const size_t BLANK_INPUT_SIZE = 41;
+
+void TransactionBuilder::set_version(uint32_t version) {
+    version_ = version;
+    dirty_ = true;
+}
+
+void TransactionBuilder::set_lock_time(uint32_t lock_time) {
+    lock_time_ = lock_time;
+    dirty_ = true;
+}
+
+size_t TransactionBuilder::add_input(const uint8_t* prev_txid, uint32_t prev_index,
+                                     const uint8_t* prev_script, size_t prev_script_len,
+                                     uint32_t sequence) {
+    TxInput input;
+    memcpy(input.prev_txid, prev_txid, 32);
+    input.prev_index = prev_index;
+    input.sequence = sequence;
+    input.prev_script.assign(prev_script, prev_script + prev_script_len);
+    inputs_.push_back(std::move(input));
+    dirty_ = true;
+    return inputs_.size() - 1;
+}
+
+size_t TransactionBuilder::add_output(uint64_t value, const uint8_t* script_pubkey, size_t len) {
+    TxOutput output;
+    output.value = value;
+    output.script_pubkey.assign(script_pubkey, script_pubkey + len);
+    outputs_.push_back(std::move(output));
+    dirty_ = true;
+    return outputs_.size() - 1;
+}
+
+size_t TransactionBuilder::add_p2pkh_output(uint64_t value, const uint8_t* pubkey_hash) {
+    uint8_t script[P2PKH_SCRIPT_SIZE];
+    p2pkh_script(pubkey_hash, script);
+    return add_output(value, script, sizeof(script));
+}
+
+void TransactionBuilder::clear() {
+    inputs_.clear();
+    outputs_.clear();
+    dirty_ = true;
+}
+
+void TransactionBuilder::prepare() {
+    if (!dirty_) {
+        return;
+    }
+
+    write_le32(version_, head_);
+    head_len_ = 4 + encode_varint(inputs_.size(), head_ + 4);
+
+    blank_inputs_.resize(inputs_.size() * BLANK_INPUT_SIZE);
+    for (size_t i = 0; i < inputs_.size(); i++) {
+        uint8_t* p = blank_inputs_.data() + i * BLANK_INPUT_SIZE;
+        memcpy(p, inputs_[i].prev_txid, 32);
+        write_le32(inputs_[i].prev_index, p + 32);
+        p[36] = 0x00;
+        write_le32(inputs_[i].sequence, p + 37);
+    }
+
+    size_t tail_size = 9 + 4 + 4;
+    for (const TxOutput& output : outputs_) {
+        tail_size += 8 + 9 + output.script_pubkey.size();
+    }
+    tail_.resize(tail_size);
+
+    uint8_t* p = tail_.data();
+    p += encode_varint(outputs_.size(), p);
+    for (const TxOutput& output : outputs_) {
+        write_le64(output.value, p);
+        p += 8;
+        p += encode_varint(output.script_pubkey.size(), p);
+        if (!output.script_pubkey.empty()) {
+            memcpy(p, output.script_pubkey.data(), output.script_pubkey.size());
+            p += output.script_pubkey.size();
+        }
+    }
+    write_le32(lock_time_, p);
+    write_le32(SIGHASH_ALL, p + 4);
+    tail_.resize(p + 8 - tail_.data());
+
+    dirty_ = false;
+}
+
+// prefix has absorbed the header and the blanked inputs before index
+void TransactionBuilder::hash_input(size_t index, const uint8_t* script_code, size_t script_code_len,
+                                    const Sha256Ctx& prefix, uint8_t* hash) const {
+    Sha256Ctx ctx = prefix;
+    const uint8_t* blank = blank_inputs_.data() + index * BLANK_INPUT_SIZE;
+
+    uint8_t varint[9];
+    ctx.update(blank, 36);
+    ctx.update(varint, encode_varint(script_code_len, varint));
+    ctx.update(script_code, script_code_len);
+    ctx.update(blank + 37, 4);
+
+    size_t after = (index + 1) * BLANK_INPUT_SIZE;
+    ctx.update(blank_inputs_.data() + after, blank_inputs_.size() - after);
+    ctx.update(tail_.data(), tail_.size());
+
+    uint8_t first[32];
+    ctx.final(first);
+    sha256_fixed<32>(first, hash);
+}
+
+bool TransactionBuilder::signature_hash(size_t index, const uint8_t* script_code, size_t script_code_len,
+                                        uint8_t* hash) {
+    if (index >= inputs_.size()) {
+        return false;
+    }
+    prepare();
+
+    Sha256Ctx prefix;
+    prefix.update(head_, head_len_);
+    prefix.update(blank_inputs_.data(), index * BLANK_INPUT_SIZE);
+    hash_input(index, script_code, script_code_len, prefix, hash);
+    return true;
+}
+
+bool TransactionBuilder::sign_prepared(size_t index, const SigningKey& key, const Sha256Ctx& prefix) {
+    if (!key.is_valid()) {
+        return false;
+    }
+
+    TxInput& input = inputs_[index];
+    uint8_t own_script[P2PKH_SCRIPT_SIZE];
+    const uint8_t* script_code = input.prev_script.data();
+    size_t script_code_len = input.prev_script.size();
+    if (script_code_len == 0) {
+        p2pkh_script(key.pubkey_hash(), own_script);
+        script_code = own_script;
+        script_code_len = sizeof(own_script);
+    } else {
+        const uint8_t* owner = p2pkh_script_hash(script_code, script_code_len);
+        if (!owner || memcmp(owner, key.pubkey_hash(), 20) != 0) {
+            return false;
+        }
+    }
+
+    uint8_t hash[32];
+    hash_input(index, script_code, script_code_len, prefix, hash);
+
+    // libsecp256k1 always produces low-S signatures, as relay policy requires
+    secp256k1_context* ctx = secp256k1_thread_context();
+    secp256k1_ecdsa_signature sig;
+    if (!secp256k1_ecdsa_sign(ctx, &sig, hash, key.private_key(), nullptr, nullptr)) {
+        return false;
+    }
+
+    uint8_t der[72];
+    size_t der_len = sizeof(der);
+    secp256k1_ecdsa_signature_serialize_der(ctx, der, &der_len, &sig);
+
+    // <sig + hash type> <pubkey>, both short enough for a direct push
+    size_t pubkey_len = key.public_key_size();
+    std::vector<uint8_t>& script_sig = input.script_sig;
+    script_sig.resize(2 + der_len + 1 + pubkey_len);
+    script_sig[0] = static_cast<uint8_t>(der_len + 1);
+    memcpy(&script_sig[1], der, der_len);
+    script_sig[1 + der_len] = static_cast<uint8_t>(SIGHASH_ALL);
+    script_sig[2 + der_len] = static_cast<uint8_t>(pubkey_len);
+    memcpy(&script_sig[3 + der_len], key.public_key(), pubkey_len);
+    return true;
+}
+
+bool TransactionBuilder::sign_input(size_t index, const SigningKey& key) {
+    if (index >= inputs_.size()) {
+        return false;
+    }
+    prepare();
+
+    Sha256Ctx prefix;
+    prefix.update(head_, head_len_);
+    prefix.update(blank_inputs_.data(), index * BLANK_INPUT_SIZE);
+    return sign_prepared(index, key, prefix);
+}
+
+bool TransactionBuilder::sign(const SigningKey* const* keys) {
+    prepare();
+
+    // Each chunk hashes its shared prefix once, then extends it by one
+    // blanked input per signature instead of starting over
+    std::atomic<bool> ok(true);
+    thread_pool().parallel_for(inputs_.size(), 8, [&](size_t begin, size_t end) {
+        Sha256Ctx prefix;
+        prefix.update(head_, head_len_);
+        prefix.update(blank_inputs_.data(), begin * BLANK_INPUT_SIZE);
+
+        for (size_t i = begin; i < end; i++) {
+            if (!keys[i] || !sign_prepared(i, *keys[i], prefix)) {
+                ok.store(false, std::memory_order_relaxed);
+            }
+            prefix.update(blank_inputs_.data() + i * BLANK_INPUT_SIZE, BLANK_INPUT_SIZE);
+        }
+    });
+    return ok.load();
+}
+
+size_t TransactionBuilder::serialized_size() const {
+    uint8_t varint[9];
+    size_t size = 4 + encode_varint(inputs_.size(), varint) + encode_varint(outputs_.size(), varint) + 4;
+    for (const TxInput& input : inputs_) {
+        size += 36 + encode_varint(input.script_sig.size(), varint) + input.script_sig.size() + 4;
+    }
+    for (const TxOutput& output : outputs_) {
+        size += 8 + encode_varint(output.script_pubkey.size(), varint) + output.script_pubkey.size();
+    }
+    return size;
+}
+
+void TransactionBuilder::serialize(std::vector<uint8_t>& out) const {
+    out.resize(serialized_size());
+    uint8_t* p = out.data();
+
+    write_le32(version_, p);
+    p += 4;
+    p += encode_varint(inputs_.size(), p);
+    for (const TxInput& input : inputs_) {
+        memcpy(p, input.prev_txid, 32);
+        write_le32(input.prev_index, p + 32);
+        p += 36;
+        p += encode_varint(input.script_sig.size(), p);
+        if (!input.script_sig.empty()) {
+            memcpy(p, input.script_sig.data(), input.script_sig.size());
+            p += input.script_sig.size();
+        }
+        write_le32(input.sequence, p);
+        p += 4;
+    }
+
+    p += encode_varint(outputs_.size(), p);
+    for (const TxOutput& output : outputs_) {
+        write_le64(output.value, p);
+        p += 8;
+        p += encode_varint(output.script_pubkey.size(), p);
+        if (!output.script_pubkey.empty()) {
+            memcpy(p, output.script_pubkey.data(), output.script_pubkey.size());
+            p += output.script_pubkey.size();
+        }
+    }
+    write_le32(lock_time_, p);
+}
+
+void TransactionBuilder::txid(uint8_t* hash) const {
+    std::vector<uint8_t> raw;
+    serialize(raw);
+    sha256_double(raw.data(), raw.size(), hash);
+}
+
+} // namespace doge
@@ -0,0 +1,101 @@
+#ifndef DOGE_TRANSACTION_H
+#define DOGE_TRANSACTION_H
+
+#include "script.h"
+#include "signing_key.h"
+#include "../utils/hash.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace doge {
+
+const uint32_t SIGHASH_ALL = 0x01;
+const uint32_t SEQUENCE_FINAL = 0xffffffff;
+
+struct TxInput {
+    uint8_t prev_txid[32];            // internal byte order, the reverse of the hex form
+    uint32_t prev_index = 0;
+    uint32_t sequence = SEQUENCE_FINAL;
+    std::vector<uint8_t> prev_script; // scriptPubKey being spent, signed as the scriptCode
+    std::vector<uint8_t> script_sig;
+};
+
+struct TxOutput {
+    uint64_t value = 0; // koinu
+    std::vector<uint8_t> script_pubkey;
+};
+
+// Legacy (non-segwit) P2PKH transaction builder and signer.
+//
+// Every legacy SIGHASH_ALL digest covers the whole transaction with all
+// but one input script blanked, so signing n inputs hashes O(n^2) bytes.
+// The builder serializes the parts that never change between inputs once
+// (header, blanked inputs, outputs and lock time) and streams them into
+// SHA-256 without building a per-input copy. Within a run of inputs the
+// hash state over the shared prefix is carried forward rather than
+// recomputed, and runs are signed in parallel on the thread pool.
+class TransactionBuilder {
+public:
+    TransactionBuilder() = default;
+
+    void set_version(uint32_t version);
+    void set_lock_time(uint32_t lock_time);
+    uint32_t version() const { return version_; }
+    uint32_t lock_time() const { return lock_time_; }
+
+    // An empty prev_script is filled with the signing key's P2PKH script
+    // when the input is signed. Returns the input's index.
+    size_t add_input(const uint8_t* prev_txid, uint32_t prev_index,
+                     const uint8_t* prev_script, size_t prev_script_len,
+                     uint32_t sequence = SEQUENCE_FINAL);
+    size_t add_output(uint64_t value, const uint8_t* script_pubkey, size_t len);
+    size_t add_p2pkh_output(uint64_t value, const uint8_t* pubkey_hash);
+    void clear();
+
+    const std::vector<TxInput>& inputs() const { return inputs_; }
+    const std::vector<TxOutput>& outputs() const { return outputs_; }
+
+    // Legacy SIGHASH_ALL digest of input index, spending script_code
+    bool signature_hash(size_t index, const uint8_t* script_code, size_t script_code_len, uint8_t* hash);
+
+    // Sign one input, or every input with keys[i] for input i. Fails if a
+    // key does not own the P2PKH script its input spends. Inputs signed
+    // before a failure keep their signatures.
+    bool sign_input(size_t index, const SigningKey& key);
+    bool sign(const SigningKey* const* keys);
+
+    size_t serialized_size() const;
+    void serialize(std::vector<uint8_t>& out) const;
+
+    // sha256_double of the serialization, internal byte order
+    void txid(uint8_t* hash) const;
+
+private:
+    // Rebuild the cached serializations after inputs or outputs changed
+    void prepare();
+
+    void hash_input(size_t index, const uint8_t* script_code, size_t script_code_len,
+                    const Sha256Ctx& prefix, uint8_t* hash) const;
+    bool sign_prepared(size_t index, const SigningKey& key, const Sha256Ctx& prefix);
+
+    uint32_t version_ = 1;
+    uint32_t lock_time_ = 0;
+    std::vector<TxInput> inputs_;
+    std::vector<TxOutput> outputs_;
+
+    // version + varint(input count)
+    uint8_t head_[13];
+    size_t head_len_ = 0;
+    // Each input as it appears when its script is blanked:
+    // outpoint (36) + empty script (1) + sequence (4)
+    std::vector<uint8_t> blank_inputs_;
+    // varint(output count) + outputs + lock time + sighash type
+    std::vector<uint8_t> tail_;
+    bool dirty_ = true;
+};
+
+} // namespace doge
+
+#endif // DOGE_TRANSACTION_H
@@ -0,0 +1,96 @@
+#include "transaction_view.h"
+#include "../utils/hash.h"
+
+namespace doge {
+
+// Smallest possible input (outpoint + empty script + sequence) and output
+// (value + empty script), to reject absurd counts before looping over them
+static const size_t MIN_INPUT_SIZE = 41;
+static const size_t MIN_OUTPUT_SIZE = 9;
+
+static bool skip_input(ByteReader& reader) {
+    const uint8_t* script;
+    size_t script_len;
+    return reader.skip(36) && reader.read_var_span(script, script_len) && reader.skip(4);
+}
+
+static bool skip_output(ByteReader& reader) {
+    const uint8_t* script;
+    size_t script_len;
+    return reader.skip(8) && reader.read_var_span(script, script_len);
+}
+
+bool parse_transaction(const uint8_t* data, size_t len, TransactionView& tx) {
+    ByteReader reader(data, len);
+    TransactionView out;
+    out.data = data;
+
+    if (!reader.read_le32(out.version) || !reader.read_varint(out.input_count)) {
+        return false;
+    }
+    // A zero input count is the segwit marker
+    if (out.input_count == 0 || out.input_count > reader.remaining() / MIN_INPUT_SIZE) {
+        return false;
+    }
+
+    out.inputs_offset = reader.position() - data;
+    for (uint64_t i = 0; i < out.input_count; i++) {
+        if (!skip_input(reader)) {
+            return false;
+        }
+    }
+
+    if (!reader.read_varint(out.output_count) || out.output_count > reader.remaining() / MIN_OUTPUT_SIZE) {
+        return false;
+    }
+    out.outputs_offset = reader.position() - data;
+    for (uint64_t i = 0; i < out.output_count; i++) {
+        if (!skip_output(reader)) {
+            return false;
+        }
+    }
+
+    if (!reader.read_le32(out.lock_time)) {
+        return false;
+    }
+    out.size = reader.position() - data;
+    tx = out;
+    return true;
+}
+
+void transaction_id(const TransactionView& tx, uint8_t* hash) {
+    sha256_double(tx.data, tx.size, hash);
+}
+
+TxInputReader::TxInputReader(const TransactionView& tx)
+    : reader_(tx.data + tx.inputs_offset, tx.size - tx.inputs_offset), left_(tx.input_count) {
+}
+
+bool TxInputReader::next(TxInputView& input) {
+    if (left_ == 0) {
+        return false;
+    }
+    // parse_transaction() has checked the bounds already
+    reader_.read_span(32, input.prev_txid);
+    reader_.read_le32(input.prev_index);
+    reader_.read_var_span(input.script_sig, input.script_sig_len);
+    reader_.read_le32(input.sequence);
+    left_--;
+    return true;
+}
+
+TxOutputReader::TxOutputReader(const TransactionView& tx)
+    : reader_(tx.data + tx.outputs_offset, tx.size - tx.outputs_offset), left_(tx.output_count) {
+}
+
+bool TxOutputReader::next(TxOutputView& output) {
+    if (left_ == 0) {
+        return false;
+    }
+    reader_.read_le64(output.value);
+    reader_.read_var_span(output.script_pubkey, output.script_pubkey_len);
+    left_--;
+    return true;
+}
+
+} // namespace doge
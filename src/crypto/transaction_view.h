@@ -0,0 +1,74 @@
+#ifndef DOGE_TRANSACTION_VIEW_H
+#define DOGE_TRANSACTION_VIEW_H
+
+#include "serialize.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace doge {
+
+struct TxInputView {
+    const uint8_t* prev_txid; // 32 bytes, internal byte order
+    uint32_t prev_index;
+    const uint8_t* script_sig;
+    size_t script_sig_len;
+    uint32_t sequence;
+};
+
+struct TxOutputView {
+    uint64_t value; // koinu
+    const uint8_t* script_pubkey;
+    size_t script_pubkey_len;
+};
+
+// A serialized transaction parsed in place. parse_transaction() walks the
+// structure once to validate it and find its end, recording only counts
+// and offsets; inputs and outputs are decoded on demand by the readers
+// below, as spans into the original buffer. The buffer must outlive the view.
+struct TransactionView {
+    const uint8_t* data = nullptr;
+    size_t size = 0; // bytes of data this transaction occupies
+
+    uint32_t version = 0;
+    uint32_t lock_time = 0;
+    uint64_t input_count = 0;
+    uint64_t output_count = 0;
+
+    size_t inputs_offset = 0;  // first input, just after its count
+    size_t outputs_offset = 0; // first output, just after its count
+};
+
+// Parse the transaction at the start of data (more may follow, as inside a
+// block). Fails on truncated or malformed data and on segwit
+// serializations, which Dogecoin does not use.
+bool parse_transaction(const uint8_t* data, size_t len, TransactionView& tx);
+
+// sha256_double over the transaction's own bytes, internal byte order
+void transaction_id(const TransactionView& tx, uint8_t* hash);
+
+// Decode a parsed transaction's inputs or outputs in order. next() returns
+// false after the last one.
+class TxInputReader {
+public:
+    explicit TxInputReader(const TransactionView& tx);
+    bool next(TxInputView& input);
+
+private:
+    ByteReader reader_;
+    uint64_t left_;
+};
+
+class TxOutputReader {
+public:
+    explicit TxOutputReader(const TransactionView& tx);
+    bool next(TxOutputView& output);
+
+private:
+    ByteReader reader_;
+    uint64_t left_;
+};
+
+} // namespace doge
+
+#endif // DOGE_TRANSACTION_VIEW_H
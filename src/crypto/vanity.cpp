@@ -0,0 +1,356 @@
+#include "vanity.h"
+#include "address.h"
+#include "entropy.h"
+#include "secp256k1_context.h"
+#include "../utils/hash.h"
+#include <cmath>
+#include <cstring>
+
+namespace doge {
+
+static const char BASE58_DIGITS[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+// Addresses are 25 bytes (version + hash160 + checksum), so at most 35 chars
+static const size_t MAX_ADDRESS_CHARS = 35;
+
+namespace {
+
+// Minimal 256-bit unsigned integer, 32-bit limbs least significant first.
+// Only what the prefix range computation needs.
+struct U256 {
+    uint32_t w[8] = {};
+
+    static U256 from_u32(uint32_t v) {
+        U256 r;
+        r.w[0] = v;
+        return r;
+    }
+
+    void mul_small(uint32_t m) {
+        uint64_t carry = 0;
+        for (int i = 0; i < 8; i++) {
+            carry += static_cast<uint64_t>(w[i]) * m;
+            w[i] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+    }
+
+    void add_small(uint32_t v) {
+        uint64_t carry = v;
+        for (int i = 0; i < 8 && carry; i++) {
+            carry += w[i];
+            w[i] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+    }
+
+    void sub(const U256& b) {
+        int64_t borrow = 0;
+        for (int i = 0; i < 8; i++) {
+            int64_t d = static_cast<int64_t>(w[i]) - b.w[i] - borrow;
+            borrow = d < 0;
+            w[i] = static_cast<uint32_t>(d + (borrow << 32));
+        }
+    }
+
+    int cmp(const U256& b) const {
+        for (int i = 7; i >= 0; i--) {
+            if (w[i] != b.w[i]) return w[i] < b.w[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    double to_double() const {
+        double r = 0;
+        for (int i = 7; i >= 0; i--) {
+            r = r * 4294967296.0 + w[i];
+        }
+        return r;
+    }
+
+    // Bits 32..191 (the hash160 of a version-stripped address number) as
+    // 20 big-endian bytes
+    void hash_bytes(uint8_t* out) const {
+        for (int i = 0; i < 5; i++) {
+            uint32_t v = w[5 - i];
+            out[i * 4 + 0] = static_cast<uint8_t>(v >> 24);
+            out[i * 4 + 1] = static_cast<uint8_t>(v >> 16);
+            out[i * 4 + 2] = static_cast<uint8_t>(v >> 8);
+            out[i * 4 + 3] = static_cast<uint8_t>(v);
+        }
+    }
+};
+
+} // namespace
+
+bool vanity_prefix_ranges(const std::string& prefix, uint8_t version,
+                          std::vector<Hash160Range>& ranges, double& expected_attempts) {
+    ranges.clear();
+    expected_attempts = 0;
+
+    // A leading '1' encodes a zero byte, which no address version is
+    if (prefix.empty() || prefix.size() > MAX_ADDRESS_CHARS || prefix[0] == '1') {
+        return false;
+    }
+
+    U256 value;
+    for (char c : prefix) {
+        const char* p = strchr(BASE58_DIGITS, c);
+        if (!p || c == '\0') {
+            return false;
+        }
+        value.mul_small(58);
+        value.add_small(static_cast<uint32_t>(p - BASE58_DIGITS));
+    }
+
+    // Address numbers for this version: [version * 2^192, (version + 1) * 2^192)
+    U256 vmin;
+    vmin.w[6] = version;
+    U256 vmax;
+    vmax.w[6] = version + 1u;
+    vmax.sub(U256::from_u32(1));
+
+    double covered = 0;
+    for (size_t len = prefix.size(); len <= MAX_ADDRESS_CHARS; len++) {
+        // Numbers with len digits starting with the prefix: [lo, hi]
+        U256 lo = value;
+        U256 hi = value;
+        hi.add_small(1);
+        for (size_t i = prefix.size(); i < len; i++) {
+            lo.mul_small(58);
+            hi.mul_small(58);
+        }
+        hi.sub(U256::from_u32(1));
+
+        if (lo.cmp(vmax) > 0 || hi.cmp(vmin) < 0) {
+            continue;
+        }
+        if (lo.cmp(vmin) < 0) lo = vmin;
+        if (hi.cmp(vmax) > 0) hi = vmax;
+
+        covered += hi.to_double() - lo.to_double() + 1;
+
+        // Drop the version; the low 32 bits are the checksum
+        lo.sub(vmin);
+        hi.sub(vmin);
+
+        Hash160Range range;
+        lo.hash_bytes(range.lo);
+        hi.hash_bytes(range.hi);
+        ranges.push_back(range);
+    }
+
+    if (ranges.empty()) {
+        return false;
+    }
+
+    expected_attempts = std::ldexp(1.0, 192) / covered;
+    return true;
+}
+
+static bool in_ranges(const uint8_t* hash, const std::vector<Hash160Range>& ranges) {
+    for (const Hash160Range& r : ranges) {
+        if (memcmp(hash, r.lo, 20) >= 0 && memcmp(hash, r.hi, 20) <= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+VanitySearch::~VanitySearch() {
+    cancel();
+}
+
+bool VanitySearch::start(const std::string& prefix, bool mainnet, bool compressed,
+                         size_t threads, std::string& error) {
+    if (running_) {
+        error = "A search is already running";
+        return false;
+    }
+    join();
+
+    uint8_t version = mainnet ? ADDRESS_VERSION_MAINNET : ADDRESS_VERSION_TESTNET;
+    if (!vanity_prefix_ranges(prefix, version, ranges_, expected_attempts_)) {
+        error = "No " + std::string(mainnet ? "mainnet" : "testnet") + " address can start with '" + prefix + "'";
+        return false;
+    }
+
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+    }
+
+    prefix_ = prefix;
+    version_ = version;
+    compressed_ = compressed;
+    stop_ = false;
+    found_ = false;
+    attempts_ = 0;
+    finished_ns_ = 0;
+    started_ = std::chrono::steady_clock::now();
+    active_workers_ = threads;
+    running_ = true;
+
+    for (size_t i = 0; i < threads; i++) {
+        workers_.emplace_back([this] { worker(); });
+    }
+    return true;
+}
+
+void VanitySearch::cancel() {
+    stop_ = true;
+    join();
+}
+
+void VanitySearch::join() {
+    for (std::thread& t : workers_) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+    workers_.clear();
+}
+
+double VanitySearch::elapsed_seconds() const {
+    if (running_) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - started_).count();
+    }
+    return finished_ns_.load() / 1e9;
+}
+
+double VanitySearch::keys_per_second() const {
+    double elapsed = elapsed_seconds();
+    return elapsed > 0 ? attempts() / elapsed : 0.0;
+}
+
+bool VanitySearch::result(std::vector<uint8_t>& private_key, std::vector<uint8_t>& public_key,
+                          std::string& address) const {
+    std::lock_guard<std::mutex> lock(result_mutex_);
+    if (!found_) {
+        return false;
+    }
+    private_key.assign(private_key_, private_key_ + 32);
+    public_key = public_key_;
+    address = address_;
+    return true;
+}
+
+// Recompute the key base + step and confirm its address really starts with
+// the prefix (a range hit can be off by the checksum at the edges)
+bool VanitySearch::check_candidate(const uint8_t* base_key, uint64_t step) {
+    secp256k1_context* ctx = secp256k1_thread_context();
+
+    uint8_t key[32];
+    uint8_t tweak[32] = {};
+    memcpy(key, base_key, 32);
+    for (int i = 0; i < 8; i++) {
+        tweak[31 - i] = static_cast<uint8_t>(step >> (8 * i));
+    }
+    if (step != 0 && !secp256k1_ec_seckey_tweak_add(ctx, key, tweak)) {
+        secure_wipe(key, sizeof(key));
+        return false;
+    }
+
+    secp256k1_pubkey pubkey;
+    uint8_t serialized[65];
+    size_t len = compressed_ ? 33 : 65;
+    unsigned int flags = compressed_ ? SECP256K1_EC_COMPRESSED : SECP256K1_EC_UNCOMPRESSED;
+    if (!secp256k1_ec_pubkey_create(ctx, &pubkey, key) ||
+        !secp256k1_ec_pubkey_serialize(ctx, serialized, &len, &pubkey, flags)) {
+        secure_wipe(key, sizeof(key));
+        return false;
+    }
+
+    ParsedAddress parsed;
+    parsed.version = version_;
+    hash160(serialized, len, parsed.hash);
+    std::string address = format_address(parsed);
+
+    if (address.compare(0, prefix_.size(), prefix_) != 0) {
+        secure_wipe(key, sizeof(key));
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(result_mutex_);
+    if (!found_) {
+        memcpy(private_key_, key, 32);
+        public_key_.assign(serialized, serialized + len);
+        address_ = address;
+        found_ = true;
+        stop_ = true;
+    }
+    secure_wipe(key, sizeof(key));
+    return true;
+}
+
+void VanitySearch::worker() {
+    secp256k1_context* ctx = secp256k1_thread_context();
+
+    const size_t BATCH = 64;
+    // Steps from one random base before drawing a new one
+    const uint64_t STEPS_PER_BASE = uint64_t(1) << 32;
+
+    size_t pubkey_len = compressed_ ? 33 : 65;
+    unsigned int flags = compressed_ ? SECP256K1_EC_COMPRESSED : SECP256K1_EC_UNCOMPRESSED;
+
+    uint8_t one[32] = {};
+    one[31] = 1;
+    secp256k1_pubkey g;
+    secp256k1_ec_pubkey_create(ctx, &g, one);
+
+    uint8_t base_key[32];
+    uint8_t pubkeys[BATCH * 65];
+    uint8_t hashes[BATCH * 20];
+
+    while (!stop_) {
+        do {
+            if (!random_bytes(base_key, 32)) {
+                stop_ = true;
+                break;
+            }
+        } while (!secp256k1_ec_seckey_verify(ctx, base_key));
+
+        secp256k1_pubkey points[2];
+        int cur = 0;
+        if (stop_ || !secp256k1_ec_pubkey_create(ctx, &points[cur], base_key)) {
+            break;
+        }
+
+        for (uint64_t step = 0; step < STEPS_PER_BASE && !stop_; step += BATCH) {
+            bool ok = true;
+            for (size_t i = 0; i < BATCH && ok; i++) {
+                size_t len = pubkey_len;
+                secp256k1_ec_pubkey_serialize(ctx, pubkeys + i * pubkey_len, &len, &points[cur], flags);
+
+                // combine() clears its output before reading the inputs, so
+                // alternate between two points. It fails only if the sum is
+                // infinity, i.e. never in practice.
+                const secp256k1_pubkey* ins[2] = {&points[cur], &g};
+                ok = secp256k1_ec_pubkey_combine(ctx, &points[cur ^ 1], ins, 2) != 0;
+                cur ^= 1;
+            }
+            if (!ok) {
+                break; // Draw a new base
+            }
+
+            hash160_many(pubkeys, pubkey_len, BATCH, hashes);
+            for (size_t i = 0; i < BATCH; i++) {
+                if (in_ranges(hashes + i * 20, ranges_) && check_candidate(base_key, step + i)) {
+                    break;
+                }
+            }
+            attempts_.fetch_add(BATCH, std::memory_order_relaxed);
+        }
+    }
+
+    secure_wipe(base_key, sizeof(base_key));
+
+    // The last worker out records the final elapsed time
+    if (active_workers_.fetch_sub(1) == 1) {
+        finished_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - started_).count();
+        running_ = false;
+    }
+}
+
+} // namespace doge
@@ -0,0 +1,88 @@
+#ifndef DOGE_VANITY_H
+#define DOGE_VANITY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace doge {
+
+// Range of hash160 values (big-endian, inclusive) whose addresses start
+// with a given prefix, up to the checksum bytes at the edges
+struct Hash160Range {
+    uint8_t lo[20];
+    uint8_t hi[20];
+};
+
+// Turn a base58 address prefix into hash160 ranges for one version byte.
+// Fails (returns false) when no address of that version can have the prefix.
+// expected_attempts receives the mean number of keys to try.
+bool vanity_prefix_ranges(const std::string& prefix, uint8_t version,
+                          std::vector<Hash160Range>& ranges, double& expected_attempts);
+
+// Searches for a key whose address starts with a prefix. Each worker
+// starts from a random key and steps it by adding G to the public key,
+// which costs one point addition per candidate instead of a scalar
+// multiplication. Candidates are hashed in batches and tested against the
+// prefix's hash160 ranges, so only a match is base58 encoded.
+class VanitySearch {
+public:
+    VanitySearch() = default;
+    ~VanitySearch();
+
+    VanitySearch(const VanitySearch&) = delete;
+    VanitySearch& operator=(const VanitySearch&) = delete;
+
+    // Start threads workers (0 = one per hardware thread). Fails with a
+    // message in error if the prefix is impossible or a search is running.
+    bool start(const std::string& prefix, bool mainnet, bool compressed,
+               size_t threads, std::string& error);
+
+    // Ask the workers to stop and wait for them
+    void cancel();
+
+    bool is_running() const { return running_.load(); }
+    bool is_found() const { return found_.load(); }
+
+    uint64_t attempts() const { return attempts_.load(std::memory_order_relaxed); }
+    double expected_attempts() const { return expected_attempts_; }
+    double elapsed_seconds() const;
+    double keys_per_second() const;
+
+    // Valid once is_found(): 32-byte secret, public key and address
+    bool result(std::vector<uint8_t>& private_key, std::vector<uint8_t>& public_key,
+                std::string& address) const;
+
+private:
+    void worker();
+    void join();
+    bool check_candidate(const uint8_t* base_key, uint64_t step);
+
+    std::string prefix_;
+    uint8_t version_ = 0;
+    bool compressed_ = true;
+    std::vector<Hash160Range> ranges_;
+    double expected_attempts_ = 0;
+
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> active_workers_{0};
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> found_{false};
+    std::atomic<uint64_t> attempts_{0};
+    std::chrono::steady_clock::time_point started_;
+    std::atomic<int64_t> finished_ns_{0}; // Elapsed time once stopped
+
+    mutable std::mutex result_mutex_;
+    uint8_t private_key_[32] = {};
+    std::vector<uint8_t> public_key_;
+    std::string address_;
+};
+
+} // namespace doge
+
+#endif // DOGE_VANITY_H
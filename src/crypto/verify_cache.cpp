@@ -0,0 +1,185 @@
+#include "verify_cache.h"
+#include "entropy.h"
+#include <chrono>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace doge {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Digest followed by the compact signature
+struct CacheKey {
+    uint8_t bytes[32 + 65];
+
+    bool operator==(const CacheKey& other) const {
+        return memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+    }
+};
+
+// Salted mix of digest and signature words. The salt is drawn per process
+// so clients cannot aim many entries at one bucket.
+struct CacheKeyHash {
+    uint64_t salt = 0;
+
+    size_t operator()(const CacheKey& key) const {
+        uint64_t a, b, c;
+        memcpy(&a, key.bytes, 8);       // digest
+        memcpy(&b, key.bytes + 33, 8);  // r
+        memcpy(&c, key.bytes + 65, 8);  // s
+
+        uint64_t h = (a ^ salt) * 0x9e3779b97f4a7c15ull;
+        h = (h ^ b ^ (h >> 29)) * 0xbf58476d1ce4e5b9ull;
+        h = (h ^ c ^ (h >> 31)) * 0x94d049bb133111ebull;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+};
+
+struct Entry {
+    CacheKey key;
+    uint8_t pubkey_hash[20];
+    Clock::time_point inserted;
+};
+
+} // namespace
+
+struct VerifyCache::Shard {
+    std::mutex mutex;
+    std::list<Entry> lru; // Most recently used first
+    std::unordered_map<CacheKey, std::list<Entry>::iterator, CacheKeyHash> index;
+    size_t capacity = 0;
+
+    void evict_to(size_t limit) {
+        while (lru.size() > limit) {
+            index.erase(lru.back().key);
+            lru.pop_back();
+        }
+    }
+};
+
+static CacheKey make_key(const uint8_t* digest, const uint8_t* signature) {
+    CacheKey key;
+    memcpy(key.bytes, digest, 32);
+    memcpy(key.bytes + 32, signature, 65);
+    return key;
+}
+
+VerifyCache::VerifyCache() : shards_(new Shard[SHARDS]) {
+    uint8_t seed[8] = {};
+    random_bytes(seed, sizeof(seed));
+    memcpy(&salt_, seed, sizeof(salt_));
+
+    CacheKeyHash hasher;
+    hasher.salt = salt_;
+    for (size_t i = 0; i < SHARDS; i++) {
+        shards_[i].index = std::unordered_map<CacheKey, std::list<Entry>::iterator, CacheKeyHash>(0, hasher);
+    }
+}
+
+VerifyCache::~VerifyCache() {
+}
+
+VerifyCache::Shard& VerifyCache::shard_for(size_t h) {
+    // Top bits pick the shard; the map buckets use the low bits
+    static_assert(SHARDS == 16, "shard index takes the top 4 bits");
+    return shards_[h >> (sizeof(size_t) * 8 - 4)];
+}
+
+void VerifyCache::configure(size_t capacity, double ttl_seconds) {
+    // Round up so the shards together hold at least capacity entries
+    size_t per_shard = (capacity + SHARDS - 1) / SHARDS;
+
+    ttl_ns_ = ttl_seconds > 0 ? static_cast<int64_t>(ttl_seconds * 1e9) : 0;
+    for (size_t i = 0; i < SHARDS; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        shards_[i].capacity = per_shard;
+        shards_[i].evict_to(per_shard);
+    }
+    capacity_ = capacity;
+}
+
+bool VerifyCache::lookup(const uint8_t* digest, const uint8_t* signature, uint8_t* pubkey_hash) {
+    CacheKey key = make_key(digest, signature);
+    size_t h = CacheKeyHash{salt_}(key);
+    Shard& shard = shard_for(h);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    int64_t ttl_ns = ttl_ns_.load(std::memory_order_relaxed);
+    if (ttl_ns > 0 && Clock::now() - it->second->inserted > std::chrono::nanoseconds(ttl_ns)) {
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Move to the front of the LRU order
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    memcpy(pubkey_hash, it->second->pubkey_hash, 20);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void VerifyCache::insert(const uint8_t* digest, const uint8_t* signature, const uint8_t* pubkey_hash) {
+    CacheKey key = make_key(digest, signature);
+    size_t h = CacheKeyHash{salt_}(key);
+    Shard& shard = shard_for(h);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.capacity == 0) {
+        return;
+    }
+
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        // Raced with another thread verifying the same signature
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    Entry entry;
+    entry.key = key;
+    memcpy(entry.pubkey_hash, pubkey_hash, 20);
+    entry.inserted = Clock::now();
+
+    shard.lru.push_front(entry);
+    shard.index.emplace(key, shard.lru.begin());
+    shard.evict_to(shard.capacity);
+}
+
+void VerifyCache::clear() {
+    for (size_t i = 0; i < SHARDS; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        shards_[i].evict_to(0);
+    }
+    hits_ = 0;
+    misses_ = 0;
+}
+
+VerifyCacheStats VerifyCache::stats() const {
+    VerifyCacheStats result;
+    result.hits = hits_.load(std::memory_order_relaxed);
+    result.misses = misses_.load(std::memory_order_relaxed);
+    result.capacity = capacity_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < SHARDS; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        result.size += shards_[i].lru.size();
+    }
+    return result;
+}
+
+VerifyCache& verify_cache() {
+    static VerifyCache cache;
+    return cache;
+}
+
+} // namespace doge
@@ -0,0 +1,63 @@
+#ifndef DOGE_VERIFY_CACHE_H
+#define DOGE_VERIFY_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace doge {
+
+struct VerifyCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t size = 0;
+    size_t capacity = 0;
+};
+
+// Bounded LRU map from (message digest, 65-byte compact signature) to the
+// hash160 of the public key it recovers, so a resent signature skips the EC
+// recovery. Split into independently locked shards. Disabled (capacity 0)
+// until configured.
+class VerifyCache {
+public:
+    static const size_t SHARDS = 16;
+
+    VerifyCache();
+    ~VerifyCache();
+
+    VerifyCache(const VerifyCache&) = delete;
+    VerifyCache& operator=(const VerifyCache&) = delete;
+
+    // capacity 0 disables the cache and drops all entries. ttl_seconds <= 0
+    // keeps entries until they are evicted.
+    void configure(size_t capacity, double ttl_seconds);
+
+    bool enabled() const { return capacity_.load(std::memory_order_relaxed) > 0; }
+
+    // On a hit copies the cached hash160 to pubkey_hash and returns true
+    bool lookup(const uint8_t* digest, const uint8_t* signature, uint8_t* pubkey_hash);
+    void insert(const uint8_t* digest, const uint8_t* signature, const uint8_t* pubkey_hash);
+
+    void clear();
+    VerifyCacheStats stats() const;
+
+private:
+    struct Shard;
+
+    Shard& shard_for(size_t h);
+
+    std::unique_ptr<Shard[]> shards_;
+    uint64_t salt_;
+    std::atomic<size_t> capacity_{0};
+    std::atomic<int64_t> ttl_ns_{0};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+// Process-wide cache consulted by verify_message_hash
+VerifyCache& verify_cache();
+
+} // namespace doge
+
+#endif // DOGE_VERIFY_CACHE_H
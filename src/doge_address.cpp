@@ -0,0 +1,83 @@
+#include "doge_address.h"
+#include "crypto/message_signer.h"
+#include "utils/hash.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstring>
+
+DogeAddress::DogeAddress() {
+}
+
+DogeAddress::~DogeAddress() {
+}
+
+void DogeAddress::_bind_methods() {
+    ClassDB::bind_static_method("DogeAddress", D_METHOD("from_string", "address"), &DogeAddress::from_string);
+    ClassDB::bind_static_method("DogeAddress", D_METHOD("from_public_key", "public_key", "mainnet"), &DogeAddress::from_public_key, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("verify_message", "message", "signature_base64"), &DogeAddress::verify_message);
+    ClassDB::bind_method(D_METHOD("get_address"), &DogeAddress::get_address);
+    ClassDB::bind_method(D_METHOD("get_pubkey_hash"), &DogeAddress::get_pubkey_hash);
+    ClassDB::bind_method(D_METHOD("get_version"), &DogeAddress::get_version);
+    ClassDB::bind_method(D_METHOD("is_mainnet"), &DogeAddress::is_mainnet);
+}
+
+Ref<DogeAddress> DogeAddress::from_string(const String& address) {
+    Ref<DogeAddress> result;
+    result.instantiate();
+
+    if (!doge::parse_address(address.utf8().get_data(), result->parsed_)) {
+        UtilityFunctions::push_error("Invalid Dogecoin address");
+        return Ref<DogeAddress>();
+    }
+
+    result->address_ = address;
+    return result;
+}
+
+Ref<DogeAddress> DogeAddress::from_public_key(const PackedByteArray& public_key, bool mainnet) {
+    if (public_key.size() != 33 && public_key.size() != 65) {
+        UtilityFunctions::push_error("Public key must be 33 or 65 bytes");
+        return Ref<DogeAddress>();
+    }
+
+    Ref<DogeAddress> result;
+    result.instantiate();
+
+    result->parsed_.version = mainnet ? doge::ADDRESS_VERSION_MAINNET : doge::ADDRESS_VERSION_TESTNET;
+    doge::hash160(public_key.ptr(), public_key.size(), result->parsed_.hash);
+    result->address_ = String(doge::format_address(result->parsed_).c_str());
+    return result;
+}
+
+bool DogeAddress::verify_message(const String& message, const String& signature_base64) {
+    if (address_.is_empty()) {
+        return false;
+    }
+
+    CharString msg_utf8 = message.utf8();
+    std::string sig_str = signature_base64.utf8().get_data();
+
+    return doge::verify_message(reinterpret_cast<const uint8_t*>(msg_utf8.get_data()), msg_utf8.length(),
+                                sig_str, parsed_);
+}
+
+String DogeAddress::get_address() const {
+    return address_;
+}
+
+PackedByteArray DogeAddress::get_pubkey_hash() const {
+    PackedByteArray result;
+    result.resize(20);
+    memcpy(result.ptrw(), parsed_.hash, 20);
+    return result;
+}
+
+int DogeAddress::get_version() const {
+    return parsed_.version;
+}
+
+bool DogeAddress::is_mainnet() const {
+    return parsed_.is_mainnet();
+}
@@ -0,0 +1,44 @@
+#ifndef DOGE_ADDRESS_CLASS_H
+#define DOGE_ADDRESS_CLASS_H
+
+#include "crypto/address.h"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+using namespace godot;
+
+// A Dogecoin address decoded once. Verifying against it compares the
+// recovered key's hash160 directly, without base58 work per call.
+class DogeAddress : public RefCounted {
+    GDCLASS(DogeAddress, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    DogeAddress();
+    ~DogeAddress();
+
+    // Parse a mainnet or testnet address
+    // Returns: null if the address is invalid
+    static Ref<DogeAddress> from_string(const String& address);
+
+    // Address of a public key (33 or 65 bytes)
+    static Ref<DogeAddress> from_public_key(const PackedByteArray& public_key, bool mainnet = true);
+
+    // Verify a signed message against this address
+    bool verify_message(const String& message, const String& signature_base64);
+
+    String get_address() const;
+    PackedByteArray get_pubkey_hash() const;
+    int get_version() const;
+    bool is_mainnet() const;
+
+private:
+    doge::ParsedAddress parsed_;
+    String address_;
+};
+
+#endif // DOGE_ADDRESS_CLASS_H
@@ -0,0 +1,178 @@
+#include "doge_address_index.h"
+#include "binding_utils.h"
+#include "crypto/address.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+DogeAddressIndex::DogeAddressIndex() {
+}
+
+DogeAddressIndex::~DogeAddressIndex() {
+}
+
+void DogeAddressIndex::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("clear", "use_bloom_filter"), &DogeAddressIndex::clear, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("reserve", "count"), &DogeAddressIndex::reserve);
+    ClassDB::bind_method(D_METHOD("add_address", "address"), &DogeAddressIndex::add_address);
+    ClassDB::bind_method(D_METHOD("add_addresses", "addresses"), &DogeAddressIndex::add_addresses);
+    ClassDB::bind_method(D_METHOD("add_pubkey_hash", "pubkey_hash"), &DogeAddressIndex::add_pubkey_hash);
+    ClassDB::bind_method(D_METHOD("has_address", "address"), &DogeAddressIndex::has_address);
+    ClassDB::bind_method(D_METHOD("has_pubkey_hash", "pubkey_hash"), &DogeAddressIndex::has_pubkey_hash);
+    ClassDB::bind_method(D_METHOD("has_script", "script_pubkey"), &DogeAddressIndex::has_script);
+    ClassDB::bind_method(D_METHOD("has_pubkey_hashes", "pubkey_hashes"), &DogeAddressIndex::has_pubkey_hashes);
+    ClassDB::bind_method(D_METHOD("save", "path"), &DogeAddressIndex::save);
+    ClassDB::bind_method(D_METHOD("load", "path"), &DogeAddressIndex::load);
+    ClassDB::bind_method(D_METHOD("get_count"), &DogeAddressIndex::get_count);
+    ClassDB::bind_method(D_METHOD("get_memory_usage"), &DogeAddressIndex::get_memory_usage);
+    ClassDB::bind_method(D_METHOD("has_bloom_filter"), &DogeAddressIndex::has_bloom_filter);
+    ClassDB::bind_method(D_METHOD("is_memory_mapped"), &DogeAddressIndex::is_memory_mapped);
+}
+
+void DogeAddressIndex::clear(bool use_bloom_filter) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    index_.clear(use_bloom_filter);
+}
+
+void DogeAddressIndex::reserve(int count) {
+    if (count <= 0) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    index_.reserve(static_cast<size_t>(count));
+}
+
+bool DogeAddressIndex::add_address(const String& address) {
+    doge::ParsedAddress parsed;
+    if (!doge::parse_address(address.utf8().get_data(), parsed)) {
+        UtilityFunctions::push_error(String("Invalid Dogecoin address: ") + address);
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return index_.insert(parsed.hash);
+}
+
+int DogeAddressIndex::add_addresses(const PackedStringArray& addresses) {
+    // Decode outside the lock; only the inserts are serialized
+    int64_t count = addresses.size();
+    std::vector<uint8_t> hashes(static_cast<size_t>(count) * 20);
+    std::vector<uint8_t> valid(static_cast<size_t>(count), 0);
+    int64_t invalid = 0;
+
+    for (int64_t i = 0; i < count; i++) {
+        doge::ParsedAddress parsed;
+        if (doge::parse_address(addresses[i].utf8().get_data(), parsed)) {
+            memcpy(&hashes[i * 20], parsed.hash, 20);
+            valid[i] = 1;
+        } else {
+            invalid++;
+        }
+    }
+
+    if (invalid > 0) {
+        UtilityFunctions::push_error(String("Skipped invalid Dogecoin addresses: ") + String::num_int64(invalid));
+    }
+
+    int added = 0;
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    index_.reserve(index_.size() + static_cast<size_t>(count - invalid));
+    for (int64_t i = 0; i < count; i++) {
+        if (valid[i] && index_.insert(&hashes[i * 20])) {
+            added++;
+        }
+    }
+    return added;
+}
+
+bool DogeAddressIndex::add_pubkey_hash(const PackedByteArray& pubkey_hash) {
+    if (pubkey_hash.size() != 20) {
+        UtilityFunctions::push_error("Pubkey hash must be 20 bytes");
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return index_.insert(pubkey_hash.ptr());
+}
+
+bool DogeAddressIndex::has_address(const String& address) {
+    doge::ParsedAddress parsed;
+    if (!doge::parse_address(address.utf8().get_data(), parsed)) {
+        return false;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.contains(parsed.hash);
+}
+
+bool DogeAddressIndex::has_pubkey_hash(const PackedByteArray& pubkey_hash) {
+    if (pubkey_hash.size() != 20) {
+        return false;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.contains(pubkey_hash.ptr());
+}
+
+bool DogeAddressIndex::has_script(const PackedByteArray& script_pubkey) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.contains_script(script_pubkey.ptr(), script_pubkey.size());
+}
+
+PackedByteArray DogeAddressIndex::has_pubkey_hashes(const PackedByteArray& pubkey_hashes) {
+    PackedByteArray result;
+    if (pubkey_hashes.size() % 20 != 0) {
+        UtilityFunctions::push_error("Pubkey hashes must be a multiple of 20 bytes");
+        return result;
+    }
+
+    size_t count = pubkey_hashes.size() / 20;
+    result.resize(count);
+    if (count > 0) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        index_.contains_many(pubkey_hashes.ptr(), count, result.ptrw());
+    }
+    return result;
+}
+
+bool DogeAddressIndex::save(const String& path) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (!index_.save(os_path(path))) {
+        UtilityFunctions::push_error(String("Failed to write address index: ") + path);
+        return false;
+    }
+    return true;
+}
+
+bool DogeAddressIndex::load(const String& path) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!index_.load(os_path(path))) {
+        UtilityFunctions::push_error(String("Failed to load address index: ") + path);
+        return false;
+    }
+    return true;
+}
+
+int DogeAddressIndex::get_count() {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return static_cast<int>(index_.size());
+}
+
+int64_t DogeAddressIndex::get_memory_usage() {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return static_cast<int64_t>(index_.byte_size());
+}
+
+bool DogeAddressIndex::has_bloom_filter() {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.has_bloom_filter();
+}
+
+bool DogeAddressIndex::is_memory_mapped() {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.is_mapped();
+}
@@ -0,0 +1,63 @@
+#ifndef DOGE_ADDRESS_INDEX_CLASS_H
+#define DOGE_ADDRESS_INDEX_CLASS_H
+
+#include "crypto/address_index.h"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <shared_mutex>
+
+using namespace godot;
+
+// Membership set of watched addresses, keyed by the 20-byte pubkey hash.
+// Addresses are decoded once on insert; lookups never touch base58. Saved
+// indexes are memory-mapped on load, so startup cost does not grow with
+// the number of addresses. Lookups may run on several threads at once.
+class DogeAddressIndex : public RefCounted {
+    GDCLASS(DogeAddressIndex, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    DogeAddressIndex();
+    ~DogeAddressIndex();
+
+    // Drop every address. The Bloom filter speeds up lookups that miss,
+    // which is most of them when scanning blocks.
+    void clear(bool use_bloom_filter = true);
+    void reserve(int count);
+
+    // Returns: true if the address was added, false if invalid or present
+    bool add_address(const String& address);
+    // Returns: number of addresses added
+    int add_addresses(const PackedStringArray& addresses);
+    bool add_pubkey_hash(const PackedByteArray& pubkey_hash);
+
+    bool has_address(const String& address);
+    bool has_pubkey_hash(const PackedByteArray& pubkey_hash);
+    bool has_script(const PackedByteArray& script_pubkey);
+
+    // One byte per 20-byte hash in pubkey_hashes: 1 if present, 0 if not
+    PackedByteArray has_pubkey_hashes(const PackedByteArray& pubkey_hashes);
+
+    bool save(const String& path);
+    bool load(const String& path);
+
+    int get_count();
+    int64_t get_memory_usage();
+    bool has_bloom_filter();
+    bool is_memory_mapped();
+
+private:
+    // Scans blocks against the index under a shared lock
+    friend class DogeBlockScanner;
+
+    doge::AddressIndex index_;
+    std::shared_mutex mutex_;
+};
+
+#endif // DOGE_ADDRESS_INDEX_CLASS_H
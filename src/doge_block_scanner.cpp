@@ -0,0 +1,120 @@
+#include "doge_block_scanner.h"
+#include "binding_utils.h"
+#include "crypto/address.h"
+#include "crypto/keypair.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+DogeBlockScanner::DogeBlockScanner() {
+    record_stats(doge::BlockScanStats(), 0, 0.0);
+}
+
+DogeBlockScanner::~DogeBlockScanner() {
+}
+
+void DogeBlockScanner::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("scan_files", "paths", "index", "mainnet"), &DogeBlockScanner::scan_files, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("scan_block", "block", "index", "mainnet"), &DogeBlockScanner::scan_block, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("get_stats"), &DogeBlockScanner::get_stats);
+}
+
+Array DogeBlockScanner::to_array(const std::vector<doge::BlockMatch>& matches, bool mainnet) const {
+    Array result;
+    doge::ParsedAddress address;
+    address.version = mainnet ? doge::ADDRESS_VERSION_MAINNET : doge::ADDRESS_VERSION_TESTNET;
+
+    for (const doge::BlockMatch& match : matches) {
+        memcpy(address.hash, match.pubkey_hash, 20);
+
+        Dictionary entry;
+        entry["block_hash"] = reversed_hex(match.block_hash);
+        entry["txid"] = reversed_hex(match.txid);
+        entry["vout"] = static_cast<int64_t>(match.vout);
+        entry["value"] = static_cast<int64_t>(match.value);
+        entry["address"] = String(doge::format_address(address).c_str());
+        entry["type"] = match.type == doge::ScriptType::P2PK ? "p2pk" : "p2pkh";
+        result.append(entry);
+    }
+    return result;
+}
+
+void DogeBlockScanner::record_stats(const doge::BlockScanStats& stats, size_t matches, double seconds) {
+    stats_ = Dictionary();
+    stats_["files"] = static_cast<int64_t>(stats.files);
+    stats_["bytes"] = static_cast<int64_t>(stats.bytes);
+    stats_["blocks"] = static_cast<int64_t>(stats.blocks);
+    stats_["bad_blocks"] = static_cast<int64_t>(stats.bad_blocks);
+    stats_["transactions"] = static_cast<int64_t>(stats.transactions);
+    stats_["outputs"] = static_cast<int64_t>(stats.outputs);
+    stats_["matches"] = static_cast<int64_t>(matches);
+    stats_["seconds"] = seconds;
+}
+
+Array DogeBlockScanner::scan_files(const PackedStringArray& paths, const Ref<DogeAddressIndex>& index, bool mainnet) {
+    if (index.is_null()) {
+        UtilityFunctions::push_error("scan_files needs a DogeAddressIndex");
+        return Array();
+    }
+
+    std::vector<std::string> os_paths(static_cast<size_t>(paths.size()));
+    for (int64_t i = 0; i < paths.size(); i++) {
+        os_paths[i] = os_path(paths[i]);
+    }
+
+    std::vector<doge::BlockMatch> matches;
+    doge::BlockScanStats stats;
+    auto started = std::chrono::steady_clock::now();
+    bool ok;
+    {
+        std::shared_lock<std::shared_mutex> lock(index->mutex_);
+        doge::BlockScanner scanner(index->index_);
+        ok = scanner.scan_files(os_paths, matches, &stats);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    if (!ok) {
+        UtilityFunctions::push_error("Block scan stopped early: a file could not be opened or has another network's magic");
+    }
+    if (stats.bad_blocks > 0) {
+        UtilityFunctions::push_error(String("Skipped malformed blocks: ") + String::num_int64(stats.bad_blocks));
+    }
+
+    record_stats(stats, matches.size(), seconds);
+    return to_array(matches, mainnet);
+}
+
+Array DogeBlockScanner::scan_block(const PackedByteArray& block, const Ref<DogeAddressIndex>& index, bool mainnet) {
+    if (index.is_null()) {
+        UtilityFunctions::push_error("scan_block needs a DogeAddressIndex");
+        return Array();
+    }
+
+    std::vector<doge::BlockMatch> matches;
+    doge::BlockScanStats stats;
+    auto started = std::chrono::steady_clock::now();
+    bool ok;
+    {
+        std::shared_lock<std::shared_mutex> lock(index->mutex_);
+        doge::BlockScanner scanner(index->index_);
+        ok = scanner.scan_block(block.ptr(), block.size(), matches, &stats);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    if (!ok) {
+        UtilityFunctions::push_error("Malformed block");
+    }
+
+    record_stats(stats, matches.size(), seconds);
+    return to_array(matches, mainnet);
+}
+
+Dictionary DogeBlockScanner::get_stats() const {
+    return stats_;
+}
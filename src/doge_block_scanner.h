@@ -0,0 +1,44 @@
+#ifndef DOGE_BLOCK_SCANNER_CLASS_H
+#define DOGE_BLOCK_SCANNER_CLASS_H
+
+#include "crypto/block_scanner.h"
+#include "doge_address_index.h"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+
+using namespace godot;
+
+// Finds payments to watched addresses in raw blocks or in the node's
+// blk*.dat files, without a full indexer. Blocks are parsed in place and
+// spread across all cores while the next ones are read from disk.
+class DogeBlockScanner : public RefCounted {
+    GDCLASS(DogeBlockScanner, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    DogeBlockScanner();
+    ~DogeBlockScanner();
+
+    // Each match is a Dictionary of block_hash, txid, vout, value (koinu),
+    // address and type ("p2pkh" or "p2pk"). mainnet selects the address form.
+    Array scan_files(const PackedStringArray& paths, const Ref<DogeAddressIndex>& index, bool mainnet = true);
+    Array scan_block(const PackedByteArray& block, const Ref<DogeAddressIndex>& index, bool mainnet = true);
+
+    // Counters of the last scan: files, bytes, blocks, bad_blocks,
+    // transactions, outputs, matches, seconds
+    Dictionary get_stats() const;
+
+private:
+    Array to_array(const std::vector<doge::BlockMatch>& matches, bool mainnet) const;
+    void record_stats(const doge::BlockScanStats& stats, size_t matches, double seconds);
+
+    Dictionary stats_;
+};
+
+#endif // DOGE_BLOCK_SCANNER_CLASS_H
@@ -0,0 +1,260 @@
+#include "doge_hd_wallet.h"
+#include "crypto/address.h"
+#include "crypto/base58.h"
+#include "crypto/bip39.h"
+#include "crypto/entropy.h"
+#include "crypto/keypair.h"
+#include "utils/hash.h"
+#include "utils/thread_pool.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstring>
+
+DogeHDWallet::DogeHDWallet() {
+}
+
+DogeHDWallet::~DogeHDWallet() {
+}
+
+void DogeHDWallet::_bind_methods() {
+    ClassDB::bind_static_method("DogeHDWallet", D_METHOD("from_seed", "seed", "mainnet"), &DogeHDWallet::from_seed, DEFVAL(true));
+    ClassDB::bind_static_method("DogeHDWallet", D_METHOD("from_mnemonic", "mnemonic", "passphrase", "mainnet"), &DogeHDWallet::from_mnemonic, DEFVAL(""), DEFVAL(true));
+    ClassDB::bind_static_method("DogeHDWallet", D_METHOD("generate_mnemonic", "word_count"), &DogeHDWallet::generate_mnemonic, DEFVAL(12));
+    ClassDB::bind_static_method("DogeHDWallet", D_METHOD("validate_mnemonic", "mnemonic"), &DogeHDWallet::validate_mnemonic);
+    ClassDB::bind_static_method("DogeHDWallet", D_METHOD("mnemonic_to_seed", "mnemonic", "passphrase"), &DogeHDWallet::mnemonic_to_seed, DEFVAL(""));
+    ClassDB::bind_static_method("DogeHDWallet", D_METHOD("from_extended_key", "extended_key"), &DogeHDWallet::from_extended_key);
+    ClassDB::bind_method(D_METHOD("get_extended_private_key", "path"), &DogeHDWallet::get_extended_private_key, DEFVAL("m"));
+    ClassDB::bind_method(D_METHOD("get_extended_public_key", "path"), &DogeHDWallet::get_extended_public_key, DEFVAL("m"));
+    ClassDB::bind_method(D_METHOD("get_address", "path"), &DogeHDWallet::get_address);
+    ClassDB::bind_method(D_METHOD("derive_keypair", "path"), &DogeHDWallet::derive_keypair);
+    ClassDB::bind_method(D_METHOD("derive_range", "path", "start", "count", "include_private"), &DogeHDWallet::derive_range, DEFVAL(false));
+    ClassDB::bind_method(D_METHOD("has_private_key"), &DogeHDWallet::has_private_key);
+    ClassDB::bind_method(D_METHOD("is_mainnet"), &DogeHDWallet::is_mainnet);
+    ClassDB::bind_method(D_METHOD("get_cached_node_count"), &DogeHDWallet::get_cached_node_count);
+    ClassDB::bind_method(D_METHOD("clear_cache"), &DogeHDWallet::clear_cache);
+}
+
+Ref<DogeHDWallet> DogeHDWallet::from_seed(const PackedByteArray& seed, bool mainnet) {
+    doge::ExtendedKey master;
+    if (!doge::bip32_master_from_seed(seed.ptr(), seed.size(), master)) {
+        UtilityFunctions::push_error("Seed must be 16 to 64 bytes and give a valid master key");
+        return Ref<DogeHDWallet>();
+    }
+
+    Ref<DogeHDWallet> result;
+    result.instantiate();
+    result->keychain_.set_root(master);
+    result->mainnet_ = mainnet;
+    master.wipe();
+    return result;
+}
+
+Ref<DogeHDWallet> DogeHDWallet::from_mnemonic(const String& mnemonic, const String& passphrase, bool mainnet) {
+    if (!validate_mnemonic(mnemonic)) {
+        UtilityFunctions::push_error("Invalid mnemonic");
+        return Ref<DogeHDWallet>();
+    }
+
+    PackedByteArray seed = mnemonic_to_seed(mnemonic, passphrase);
+    Ref<DogeHDWallet> result = from_seed(seed, mainnet);
+    doge::secure_wipe(seed.ptrw(), seed.size());
+    return result;
+}
+
+String DogeHDWallet::generate_mnemonic(int word_count) {
+    std::string mnemonic;
+    if (!doge::bip39_generate_mnemonic(word_count > 0 ? static_cast<size_t>(word_count) : 0, mnemonic)) {
+        UtilityFunctions::push_error("Word count must be 12, 15, 18, 21 or 24");
+        return String();
+    }
+    String result = String(mnemonic.c_str());
+    doge::secure_wipe(&mnemonic[0], mnemonic.size());
+    return result;
+}
+
+bool DogeHDWallet::validate_mnemonic(const String& mnemonic) {
+    CharString utf8 = mnemonic.utf8();
+    return doge::bip39_validate_mnemonic(std::string(utf8.get_data(), utf8.length()));
+}
+
+PackedByteArray DogeHDWallet::mnemonic_to_seed(const String& mnemonic, const String& passphrase) {
+    CharString mnemonic_utf8 = mnemonic.utf8();
+    CharString passphrase_utf8 = passphrase.utf8();
+
+    PackedByteArray seed;
+    seed.resize(64);
+    doge::bip39_mnemonic_to_seed(std::string(mnemonic_utf8.get_data(), mnemonic_utf8.length()),
+                                 std::string(passphrase_utf8.get_data(), passphrase_utf8.length()),
+                                 seed.ptrw());
+    return seed;
+}
+
+Ref<DogeHDWallet> DogeHDWallet::from_extended_key(const String& extended_key) {
+    doge::ExtendedKey key;
+    bool mainnet = true;
+    if (!doge::bip32_deserialize(extended_key.utf8().get_data(), key, mainnet)) {
+        UtilityFunctions::push_error("Invalid extended key");
+        return Ref<DogeHDWallet>();
+    }
+
+    Ref<DogeHDWallet> result;
+    result.instantiate();
+    result->keychain_.set_root(key);
+    result->mainnet_ = mainnet;
+    key.wipe();
+    return result;
+}
+
+bool DogeHDWallet::derive_node(const String& path, doge::ExtendedKey& out) {
+    std::vector<uint32_t> indices;
+    if (!doge::bip32_parse_path(path.utf8().get_data(), indices)) {
+        UtilityFunctions::push_error(String("Invalid derivation path: ") + path);
+        return false;
+    }
+    if (!keychain_.derive(indices, out)) {
+        UtilityFunctions::push_error(String("Failed to derive ") + path);
+        return false;
+    }
+    return true;
+}
+
+String DogeHDWallet::get_extended_private_key(const String& path) {
+    if (!has_private_key()) {
+        UtilityFunctions::push_error("Wallet has no private key");
+        return String();
+    }
+
+    doge::ExtendedKey node;
+    if (!derive_node(path, node)) {
+        return String();
+    }
+    String result = String(doge::bip32_serialize(node, mainnet_).c_str());
+    node.wipe();
+    return result;
+}
+
+String DogeHDWallet::get_extended_public_key(const String& path) {
+    doge::ExtendedKey node;
+    if (!derive_node(path, node)) {
+        return String();
+    }
+    String result = String(doge::bip32_serialize(node.neutered(), mainnet_).c_str());
+    node.wipe();
+    return result;
+}
+
+String DogeHDWallet::get_address(const String& path) {
+    doge::ExtendedKey node;
+    if (!derive_node(path, node)) {
+        return String();
+    }
+
+    doge::ParsedAddress address;
+    address.version = mainnet_ ? doge::ADDRESS_VERSION_MAINNET : doge::ADDRESS_VERSION_TESTNET;
+    doge::hash160_fixed<33>(node.public_key, address.hash);
+    node.wipe();
+    return String(doge::format_address(address).c_str());
+}
+
+Dictionary DogeHDWallet::derive_keypair(const String& path) {
+    Dictionary result;
+
+    doge::ExtendedKey node;
+    if (!derive_node(path, node)) {
+        return result;
+    }
+
+    std::vector<uint8_t> public_key(node.public_key, node.public_key + 33);
+    String wif;
+    if (node.has_private) {
+        std::vector<uint8_t> private_key(node.private_key, node.private_key + 32);
+        wif = String(doge::private_key_to_wif(private_key, true, mainnet_).c_str());
+        doge::secure_wipe(private_key.data(), private_key.size());
+    }
+    node.wipe();
+
+    result["private_key"] = wif;
+    result["public_key"] = String(doge::bytes_to_hex(public_key).c_str());
+    result["address"] = String(doge::public_key_to_address(public_key, mainnet_).c_str());
+
+    return result;
+}
+
+Dictionary DogeHDWallet::derive_range(const String& path, int start, int count, bool include_private) {
+    Dictionary result;
+
+    if (start < 0 || count <= 0) {
+        UtilityFunctions::push_error("start must be >= 0 and count > 0");
+        return result;
+    }
+    if (include_private && !has_private_key()) {
+        UtilityFunctions::push_error("Wallet has no private key");
+        return result;
+    }
+
+    std::vector<uint32_t> indices;
+    if (!doge::bip32_parse_path(path.utf8().get_data(), indices)) {
+        UtilityFunctions::push_error(String("Invalid derivation path: ") + path);
+        return result;
+    }
+
+    PackedByteArray public_keys;
+    PackedByteArray private_keys;
+    std::vector<uint8_t> hashes(static_cast<size_t>(count) * 20);
+    public_keys.resize(static_cast<int64_t>(count) * 33);
+    if (include_private) {
+        private_keys.resize(static_cast<int64_t>(count) * 32);
+    }
+
+    if (!keychain_.derive_range(indices, static_cast<uint32_t>(start), static_cast<size_t>(count),
+                                public_keys.ptrw(), hashes.data(),
+                                include_private ? private_keys.ptrw() : nullptr)) {
+        UtilityFunctions::push_error(String("Failed to derive range under ") + path);
+        return result;
+    }
+
+    PackedStringArray addresses;
+    addresses.resize(count);
+    String* addresses_w = addresses.ptrw();
+    uint8_t version = mainnet_ ? doge::ADDRESS_VERSION_MAINNET : doge::ADDRESS_VERSION_TESTNET;
+
+    // Format into the preallocated slots on the pool, as generate_keypairs does
+    doge::thread_pool().parallel_for(static_cast<size_t>(count), 256, [&](size_t begin, size_t end) {
+        uint8_t payload[21];
+        char buf[doge::base58_max_encoded_len(25) + 1];
+        payload[0] = version;
+
+        for (size_t i = begin; i < end; i++) {
+            memcpy(payload + 1, hashes.data() + i * 20, 20);
+            buf[doge::base58check_encode_to(payload, 21, buf)] = '\0';
+            addresses_w[i] = String(buf);
+        }
+    });
+
+    result["public_keys"] = public_keys;
+    result["addresses"] = addresses;
+    if (include_private) {
+        result["private_keys"] = private_keys;
+    }
+
+    return result;
+}
+
+bool DogeHDWallet::has_private_key() const {
+    return keychain_.root().has_private;
+}
+
+bool DogeHDWallet::is_mainnet() const {
+    return mainnet_;
+}
+
+int DogeHDWallet::get_cached_node_count() {
+    return static_cast<int>(keychain_.cached_nodes());
+}
+
+void DogeHDWallet::clear_cache() {
+    keychain_.clear_cache();
+}
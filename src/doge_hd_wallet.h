@@ -0,0 +1,73 @@
+#ifndef DOGE_HD_WALLET_H
+#define DOGE_HD_WALLET_H
+
+#include "crypto/bip32.h"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+using namespace godot;
+
+// BIP32 hierarchical deterministic wallet: every key is derived from one
+// seed (or one account xpub), so a single backup restores all addresses.
+// Derived parent nodes are cached, so walking the addresses of an account
+// pays for the account path once.
+class DogeHDWallet : public RefCounted {
+    GDCLASS(DogeHDWallet, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    DogeHDWallet();
+    ~DogeHDWallet();
+
+    // Master key from a 16-64 byte seed
+    // Returns: null if the seed is rejected
+    static Ref<DogeHDWallet> from_seed(const PackedByteArray& seed, bool mainnet = true);
+
+    // Restore from a BIP39 mnemonic and optional passphrase
+    // Returns: null if the mnemonic is invalid
+    static Ref<DogeHDWallet> from_mnemonic(const String& mnemonic, const String& passphrase = "", bool mainnet = true);
+
+    // BIP39 helpers: a fresh 12-24 word mnemonic, a checksum check, and the
+    // 64-byte seed (2048 rounds of PBKDF2-HMAC-SHA512)
+    static String generate_mnemonic(int word_count = 12);
+    static bool validate_mnemonic(const String& mnemonic);
+    static PackedByteArray mnemonic_to_seed(const String& mnemonic, const String& passphrase = "");
+
+    // Import a dgpv/dgub (or tprv/tpub) key. A public key derives
+    // addresses only.
+    static Ref<DogeHDWallet> from_extended_key(const String& extended_key);
+
+    // Paths look like "m/44'/3'/0'/0/5" and are relative to the imported key
+    String get_extended_private_key(const String& path = "m");
+    String get_extended_public_key(const String& path = "m");
+    String get_address(const String& path);
+
+    // Returns: {private_key: String (WIF, empty for public wallets),
+    //           public_key: String (hex), address: String}
+    Dictionary derive_keypair(const String& path);
+
+    // Children start .. start + count - 1 of the node at path
+    // Returns: {public_keys: PackedByteArray (33 bytes each),
+    //           addresses: PackedStringArray,
+    //           private_keys: PackedByteArray (32 bytes each, only if include_private)}
+    Dictionary derive_range(const String& path, int start, int count, bool include_private = false);
+
+    bool has_private_key() const;
+    bool is_mainnet() const;
+
+    int get_cached_node_count();
+    void clear_cache();
+
+private:
+    bool derive_node(const String& path, doge::ExtendedKey& out);
+
+    doge::Bip32Keychain keychain_;
+    bool mainnet_ = true;
+};
+
+#endif // DOGE_HD_WALLET_H
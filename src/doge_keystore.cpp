@@ -0,0 +1,238 @@
+#include "doge_keystore.h"
+#include "binding_utils.h"
+#include "crypto/address.h"
+#include "crypto/entropy.h"
+#include "crypto/keypair.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+DogeKeystore::DogeKeystore() {
+}
+
+DogeKeystore::~DogeKeystore() {
+}
+
+void DogeKeystore::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("open", "path"), &DogeKeystore::open);
+    ClassDB::bind_method(D_METHOD("save", "path"), &DogeKeystore::save);
+    ClassDB::bind_method(D_METHOD("close"), &DogeKeystore::close);
+    ClassDB::bind_method(D_METHOD("add_private_key", "private_key", "compressed", "mainnet"), &DogeKeystore::add_private_key, DEFVAL(true), DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("add_wif", "wif"), &DogeKeystore::add_wif);
+    ClassDB::bind_method(D_METHOD("import_wifs", "wifs"), &DogeKeystore::import_wifs);
+    ClassDB::bind_method(D_METHOD("get_count"), &DogeKeystore::get_count);
+    ClassDB::bind_method(D_METHOD("find_address", "address"), &DogeKeystore::find_address);
+    ClassDB::bind_method(D_METHOD("find_pubkey_hash", "pubkey_hash"), &DogeKeystore::find_pubkey_hash);
+    ClassDB::bind_method(D_METHOD("get_signing_key", "index"), &DogeKeystore::get_signing_key);
+    ClassDB::bind_method(D_METHOD("get_address", "index"), &DogeKeystore::get_address);
+    ClassDB::bind_method(D_METHOD("get_wif", "index"), &DogeKeystore::get_wif);
+    ClassDB::bind_method(D_METHOD("get_public_key", "index"), &DogeKeystore::get_public_key);
+    ClassDB::bind_method(D_METHOD("get_pubkey_hash", "index"), &DogeKeystore::get_pubkey_hash);
+    ClassDB::bind_method(D_METHOD("is_compressed", "index"), &DogeKeystore::is_compressed);
+    ClassDB::bind_method(D_METHOD("is_mainnet", "index"), &DogeKeystore::is_mainnet);
+}
+
+bool DogeKeystore::open(const String& path) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!keystore_.open(os_path(path))) {
+        UtilityFunctions::push_error(String("Failed to open keystore: ") + path);
+        return false;
+    }
+    return true;
+}
+
+bool DogeKeystore::save(const String& path) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!keystore_.save(os_path(path))) {
+        UtilityFunctions::push_error(String("Failed to write keystore: ") + path);
+        return false;
+    }
+    return true;
+}
+
+void DogeKeystore::close() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    keystore_.close();
+}
+
+int DogeKeystore::add_private_key(const PackedByteArray& private_key, bool compressed, bool mainnet) {
+    if (private_key.size() != 32) {
+        UtilityFunctions::push_error("Private key must be 32 bytes");
+        return -1;
+    }
+
+    size_t index;
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!keystore_.add(private_key.ptr(), compressed, mainnet, index)) {
+        UtilityFunctions::push_error("Invalid private key");
+        return -1;
+    }
+    return static_cast<int>(index);
+}
+
+int DogeKeystore::add_wif(const String& wif) {
+    std::string wif_str = wif.utf8().get_data();
+    size_t index;
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    keystore_.add_wifs(&wif_str, 1, &index);
+    doge::secure_wipe(&wif_str[0], wif_str.size());
+
+    if (index == SIZE_MAX) {
+        UtilityFunctions::push_error("Invalid WIF private key");
+        return -1;
+    }
+    return static_cast<int>(index);
+}
+
+int DogeKeystore::import_wifs(const PackedStringArray& wifs) {
+    int64_t count = wifs.size();
+    std::vector<std::string> wif_strs(static_cast<size_t>(count));
+    for (int64_t i = 0; i < count; i++) {
+        wif_strs[i] = wifs[i].utf8().get_data();
+    }
+
+    std::vector<size_t> indices(static_cast<size_t>(count));
+    size_t added;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        added = keystore_.add_wifs(wif_strs.data(), wif_strs.size(), indices.data());
+    }
+
+    int64_t invalid = 0;
+    for (int64_t i = 0; i < count; i++) {
+        invalid += indices[i] == SIZE_MAX ? 1 : 0;
+        doge::secure_wipe(&wif_strs[i][0], wif_strs[i].size());
+    }
+    if (invalid > 0) {
+        UtilityFunctions::push_error(String("Skipped invalid WIF private keys: ") + String::num_int64(invalid));
+    }
+    return static_cast<int>(added);
+}
+
+int DogeKeystore::get_count() {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return static_cast<int>(keystore_.size());
+}
+
+int DogeKeystore::find_address(const String& address) {
+    doge::ParsedAddress parsed;
+    if (!doge::parse_address(address.utf8().get_data(), parsed)) {
+        return -1;
+    }
+
+    size_t index;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (!keystore_.find(parsed.hash, index) || keystore_.record(index)->mainnet() != parsed.is_mainnet()) {
+        return -1;
+    }
+    return static_cast<int>(index);
+}
+
+int DogeKeystore::find_pubkey_hash(const PackedByteArray& pubkey_hash) {
+    if (pubkey_hash.size() != 20) {
+        return -1;
+    }
+
+    size_t index;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return keystore_.find(pubkey_hash.ptr(), index) ? static_cast<int>(index) : -1;
+}
+
+// Caller holds the lock
+const doge::KeystoreRecord* DogeKeystore::checked_record(int index) {
+    const doge::KeystoreRecord* record = index >= 0 ? keystore_.record(static_cast<size_t>(index)) : nullptr;
+    if (!record) {
+        UtilityFunctions::push_error(String("Keystore index out of range: ") + String::num_int64(index));
+    }
+    return record;
+}
+
+Ref<DogeSigningKey> DogeKeystore::get_signing_key(int index) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const doge::KeystoreRecord* record = checked_record(index);
+    if (!record) {
+        return Ref<DogeSigningKey>();
+    }
+
+    Ref<DogeSigningKey> key;
+    key.instantiate();
+    if (!key->key_.set_private_key(record->private_key, record->public_key, record->compressed(), record->mainnet())) {
+        UtilityFunctions::push_error("Invalid private key in keystore");
+        return Ref<DogeSigningKey>();
+    }
+    return key;
+}
+
+String DogeKeystore::get_address(int index) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const doge::KeystoreRecord* record = checked_record(index);
+    if (!record) {
+        return String();
+    }
+
+    doge::ParsedAddress address;
+    address.version = record->mainnet() ? doge::ADDRESS_VERSION_MAINNET : doge::ADDRESS_VERSION_TESTNET;
+    memcpy(address.hash, record->pubkey_hash, 20);
+    return String(doge::format_address(address).c_str());
+}
+
+String DogeKeystore::get_wif(int index) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const doge::KeystoreRecord* record = checked_record(index);
+    if (!record) {
+        return String();
+    }
+
+    std::vector<uint8_t> private_key(record->private_key, record->private_key + 32);
+    std::string wif = doge::private_key_to_wif(private_key, record->compressed(), record->mainnet());
+    doge::secure_wipe(private_key.data(), private_key.size());
+
+    String result = String(wif.c_str());
+    doge::secure_wipe(&wif[0], wif.size());
+    return result;
+}
+
+PackedByteArray DogeKeystore::get_public_key(int index) {
+    PackedByteArray result;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const doge::KeystoreRecord* record = checked_record(index);
+    if (!record) {
+        return result;
+    }
+
+    uint8_t public_key[65];
+    size_t len = doge::keystore_public_key(*record, public_key);
+    result.resize(len);
+    if (len > 0) {
+        memcpy(result.ptrw(), public_key, len);
+    }
+    return result;
+}
+
+PackedByteArray DogeKeystore::get_pubkey_hash(int index) {
+    PackedByteArray result;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const doge::KeystoreRecord* record = checked_record(index);
+    if (record) {
+        result.resize(20);
+        memcpy(result.ptrw(), record->pubkey_hash, 20);
+    }
+    return result;
+}
+
+bool DogeKeystore::is_compressed(int index) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const doge::KeystoreRecord* record = checked_record(index);
+    return record && record->compressed();
+}
+
+bool DogeKeystore::is_mainnet(int index) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const doge::KeystoreRecord* record = checked_record(index);
+    return record && record->mainnet();
+}
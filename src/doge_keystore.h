@@ -0,0 +1,62 @@
+#ifndef DOGE_KEYSTORE_CLASS_H
+#define DOGE_KEYSTORE_CLASS_H
+
+#include "crypto/keystore.h"
+#include "doge_signing_key.h"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <shared_mutex>
+
+using namespace godot;
+
+// Binary key file, memory-mapped on open. Public keys and hashes are
+// stored next to each secret, so opening a wallet parses nothing and a
+// key costs work only when it is first used.
+class DogeKeystore : public RefCounted {
+    GDCLASS(DogeKeystore, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    DogeKeystore();
+    ~DogeKeystore();
+
+    bool open(const String& path);
+    bool save(const String& path);
+    void close();
+
+    // Returns: index of the key, or -1 if it is invalid
+    int add_private_key(const PackedByteArray& private_key, bool compressed = true, bool mainnet = true);
+    int add_wif(const String& wif);
+
+    // Migrate WIF strings in one call, derived across all cores
+    // Returns: number of keys added
+    int import_wifs(const PackedStringArray& wifs);
+
+    int get_count();
+
+    // Returns: index, or -1 if the key is not in the store
+    int find_address(const String& address);
+    int find_pubkey_hash(const PackedByteArray& pubkey_hash);
+
+    Ref<DogeSigningKey> get_signing_key(int index);
+    String get_address(int index);
+    String get_wif(int index);
+    PackedByteArray get_public_key(int index);
+    PackedByteArray get_pubkey_hash(int index);
+    bool is_compressed(int index);
+    bool is_mainnet(int index);
+
+private:
+    const doge::KeystoreRecord* checked_record(int index);
+
+    doge::Keystore keystore_;
+    std::shared_mutex mutex_;
+};
+
+#endif // DOGE_KEYSTORE_CLASS_H
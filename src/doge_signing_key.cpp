@@ -0,0 +1,148 @@
+#include "doge_signing_key.h"
+#include "crypto/keypair.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstring>
+#include <vector>
+
+DogeSigningKey::DogeSigningKey() {
+}
+
+DogeSigningKey::~DogeSigningKey() {
+}
+
+void DogeSigningKey::_bind_methods() {
+    ClassDB::bind_static_method("DogeSigningKey", D_METHOD("from_wif", "wif"), &DogeSigningKey::from_wif);
+    ClassDB::bind_static_method("DogeSigningKey", D_METHOD("from_bytes", "private_key", "compressed", "mainnet"), &DogeSigningKey::from_bytes, DEFVAL(true), DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("sign", "message"), &DogeSigningKey::sign);
+    ClassDB::bind_method(D_METHOD("sign_bytes", "data"), &DogeSigningKey::sign_bytes);
+    ClassDB::bind_method(D_METHOD("sign_batch", "messages"), &DogeSigningKey::sign_batch);
+    ClassDB::bind_method(D_METHOD("get_address"), &DogeSigningKey::get_address);
+    ClassDB::bind_method(D_METHOD("get_wif"), &DogeSigningKey::get_wif);
+    ClassDB::bind_method(D_METHOD("get_public_key"), &DogeSigningKey::get_public_key);
+    ClassDB::bind_method(D_METHOD("get_public_key_hex"), &DogeSigningKey::get_public_key_hex);
+    ClassDB::bind_method(D_METHOD("get_pubkey_hash"), &DogeSigningKey::get_pubkey_hash);
+    ClassDB::bind_method(D_METHOD("is_compressed"), &DogeSigningKey::is_compressed);
+    ClassDB::bind_method(D_METHOD("is_mainnet"), &DogeSigningKey::is_mainnet);
+}
+
+Ref<DogeSigningKey> DogeSigningKey::from_wif(const String& wif) {
+    Ref<DogeSigningKey> key;
+    key.instantiate();
+
+    if (!key->key_.set_wif(wif.utf8().get_data())) {
+        UtilityFunctions::push_error("Invalid WIF private key");
+        return Ref<DogeSigningKey>();
+    }
+
+    return key;
+}
+
+Ref<DogeSigningKey> DogeSigningKey::from_bytes(const PackedByteArray& private_key, bool compressed, bool mainnet) {
+    if (private_key.size() != 32) {
+        UtilityFunctions::push_error("Private key must be 32 bytes");
+        return Ref<DogeSigningKey>();
+    }
+
+    Ref<DogeSigningKey> key;
+    key.instantiate();
+
+    if (!key->key_.set_private_key(private_key.ptr(), compressed, mainnet)) {
+        UtilityFunctions::push_error("Invalid private key");
+        return Ref<DogeSigningKey>();
+    }
+
+    return key;
+}
+
+String DogeSigningKey::sign(const String& message) {
+    CharString msg_utf8 = message.utf8();
+    std::string signature = key_.sign(reinterpret_cast<const uint8_t*>(msg_utf8.get_data()), msg_utf8.length());
+
+    if (signature.empty()) {
+        UtilityFunctions::push_error("Failed to sign message");
+        return String();
+    }
+
+    return String(signature.c_str());
+}
+
+String DogeSigningKey::sign_bytes(const PackedByteArray& data) {
+    std::string signature = key_.sign(data.ptr(), data.size());
+
+    if (signature.empty()) {
+        UtilityFunctions::push_error("Failed to sign data");
+        return String();
+    }
+
+    return String(signature.c_str());
+}
+
+PackedStringArray DogeSigningKey::sign_batch(const PackedStringArray& messages) {
+    PackedStringArray result;
+    if (!key_.is_valid()) {
+        UtilityFunctions::push_error("Signing key is not initialized");
+        return result;
+    }
+
+    int64_t count = messages.size();
+    std::vector<std::string> msg_strs(count);
+    for (int64_t i = 0; i < count; i++) {
+        CharString msg_utf8 = messages[i].utf8();
+        msg_strs[i].assign(msg_utf8.get_data(), msg_utf8.length());
+    }
+
+    std::vector<std::string> signatures(count);
+    key_.sign_batch(msg_strs.data(), count, signatures.data());
+
+    result.resize(count);
+    String* result_w = result.ptrw();
+    for (int64_t i = 0; i < count; i++) {
+        result_w[i] = String(signatures[i].c_str());
+    }
+
+    return result;
+}
+
+String DogeSigningKey::get_address() const {
+    return String(key_.address().c_str());
+}
+
+String DogeSigningKey::get_wif() const {
+    return String(key_.wif().c_str());
+}
+
+PackedByteArray DogeSigningKey::get_public_key() const {
+    PackedByteArray result;
+    if (key_.is_valid()) {
+        result.resize(key_.public_key_size());
+        memcpy(result.ptrw(), key_.public_key(), key_.public_key_size());
+    }
+    return result;
+}
+
+String DogeSigningKey::get_public_key_hex() const {
+    if (!key_.is_valid()) {
+        return String();
+    }
+    return String(doge::bytes_to_hex(key_.public_key(), key_.public_key_size()).c_str());
+}
+
+PackedByteArray DogeSigningKey::get_pubkey_hash() const {
+    PackedByteArray result;
+    if (key_.is_valid()) {
+        result.resize(20);
+        memcpy(result.ptrw(), key_.pubkey_hash(), 20);
+    }
+    return result;
+}
+
+bool DogeSigningKey::is_compressed() const {
+    return key_.is_compressed();
+}
+
+bool DogeSigningKey::is_mainnet() const {
+    return key_.is_mainnet();
+}
@@ -0,0 +1,56 @@
+#ifndef DOGE_SIGNING_KEY_CLASS_H
+#define DOGE_SIGNING_KEY_CLASS_H
+
+#include "crypto/signing_key.h"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+using namespace godot;
+
+// A private key parsed and validated once, with its public key, hash160
+// and address derived up front. Use it for keys that sign many messages.
+class DogeSigningKey : public RefCounted {
+    GDCLASS(DogeSigningKey, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    DogeSigningKey();
+    ~DogeSigningKey();
+
+    // Construct from a WIF string, or from 32 raw secret bytes
+    // Returns: null on an invalid key
+    static Ref<DogeSigningKey> from_wif(const String& wif);
+    static Ref<DogeSigningKey> from_bytes(const PackedByteArray& private_key, bool compressed = true, bool mainnet = true);
+
+    // Sign a message (same format as DogeWallet.sign_message)
+    String sign(const String& message);
+
+    // Sign raw bytes as the message
+    String sign_bytes(const PackedByteArray& data);
+
+    // Sign many messages in one call, spread across all cores
+    PackedStringArray sign_batch(const PackedStringArray& messages);
+
+    String get_address() const;
+    String get_wif() const;
+    PackedByteArray get_public_key() const;
+    String get_public_key_hex() const;
+    PackedByteArray get_pubkey_hash() const;
+    bool is_compressed() const;
+    bool is_mainnet() const;
+
+private:
+    // Builds keys from stored records without re-deriving the public key
+    friend class DogeKeystore;
+    // Signs transaction inputs with the already parsed secret
+    friend class DogeTransactionBuilder;
+
+    doge::SigningKey key_;
+};
+
+#endif // DOGE_SIGNING_KEY_CLASS_H
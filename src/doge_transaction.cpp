@@ -0,0 +1,193 @@
+#include "doge_transaction.h"
+#include "binding_utils.h"
+#include "crypto/address.h"
+#include "crypto/keypair.h"
+#include "crypto/script.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstring>
+#include <vector>
+
+DogeTransaction::DogeTransaction() {
+}
+
+DogeTransaction::~DogeTransaction() {
+}
+
+void DogeTransaction::_bind_methods() {
+    ClassDB::bind_static_method("DogeTransaction", D_METHOD("from_bytes", "raw", "mainnet"), &DogeTransaction::from_bytes, DEFVAL(true));
+    ClassDB::bind_static_method("DogeTransaction", D_METHOD("from_hex", "hex", "mainnet"), &DogeTransaction::from_hex, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("get_txid"), &DogeTransaction::get_txid);
+    ClassDB::bind_method(D_METHOD("get_version"), &DogeTransaction::get_version);
+    ClassDB::bind_method(D_METHOD("get_lock_time"), &DogeTransaction::get_lock_time);
+    ClassDB::bind_method(D_METHOD("get_size"), &DogeTransaction::get_size);
+    ClassDB::bind_method(D_METHOD("get_input_count"), &DogeTransaction::get_input_count);
+    ClassDB::bind_method(D_METHOD("get_output_count"), &DogeTransaction::get_output_count);
+    ClassDB::bind_method(D_METHOD("get_inputs"), &DogeTransaction::get_inputs);
+    ClassDB::bind_method(D_METHOD("get_outputs"), &DogeTransaction::get_outputs);
+    ClassDB::bind_method(D_METHOD("get_output_value", "index"), &DogeTransaction::get_output_value);
+    ClassDB::bind_method(D_METHOD("get_output_address", "index"), &DogeTransaction::get_output_address);
+    ClassDB::bind_method(D_METHOD("get_total_output"), &DogeTransaction::get_total_output);
+    ClassDB::bind_method(D_METHOD("to_bytes"), &DogeTransaction::to_bytes);
+}
+
+Ref<DogeTransaction> DogeTransaction::from_bytes(const PackedByteArray& raw, bool mainnet) {
+    Ref<DogeTransaction> tx;
+    tx.instantiate();
+
+    // Shares raw's buffer; views point into it for the object's lifetime
+    tx->raw_ = raw;
+    tx->mainnet_ = mainnet;
+    if (!doge::parse_transaction(tx->raw_.ptr(), tx->raw_.size(), tx->view_) ||
+        tx->view_.size != static_cast<size_t>(tx->raw_.size())) {
+        UtilityFunctions::push_error("Invalid raw transaction");
+        return Ref<DogeTransaction>();
+    }
+
+    return tx;
+}
+
+Ref<DogeTransaction> DogeTransaction::from_hex(const String& hex, bool mainnet) {
+    std::vector<uint8_t> bytes;
+    if (!doge::hex_to_bytes(hex.utf8().get_data(), bytes)) {
+        UtilityFunctions::push_error("Invalid hex transaction");
+        return Ref<DogeTransaction>();
+    }
+
+    PackedByteArray raw;
+    raw.resize(bytes.size());
+    if (!bytes.empty()) {
+        memcpy(raw.ptrw(), bytes.data(), bytes.size());
+    }
+    return from_bytes(raw, mainnet);
+}
+
+static PackedByteArray to_packed(const uint8_t* data, size_t len) {
+    PackedByteArray result;
+    result.resize(len);
+    if (len > 0) {
+        memcpy(result.ptrw(), data, len);
+    }
+    return result;
+}
+
+String DogeTransaction::get_txid() {
+    if (txid_.is_empty()) {
+        uint8_t hash[32];
+        doge::transaction_id(view_, hash);
+        txid_ = reversed_hex(hash);
+    }
+    return txid_;
+}
+
+int DogeTransaction::get_version() const {
+    return static_cast<int>(view_.version);
+}
+
+int DogeTransaction::get_lock_time() const {
+    return static_cast<int>(view_.lock_time);
+}
+
+int DogeTransaction::get_size() const {
+    return static_cast<int>(view_.size);
+}
+
+int DogeTransaction::get_input_count() const {
+    return static_cast<int>(view_.input_count);
+}
+
+int DogeTransaction::get_output_count() const {
+    return static_cast<int>(view_.output_count);
+}
+
+Array DogeTransaction::get_inputs() {
+    if (!inputs_ready_) {
+        doge::TxInputReader reader(view_);
+        doge::TxInputView input;
+        while (reader.next(input)) {
+            Dictionary entry;
+            entry["txid"] = reversed_hex(input.prev_txid);
+            entry["vout"] = static_cast<int64_t>(input.prev_index);
+            entry["script_sig"] = to_packed(input.script_sig, input.script_sig_len);
+            entry["sequence"] = static_cast<int64_t>(input.sequence);
+            inputs_.append(entry);
+        }
+        inputs_ready_ = true;
+    }
+    // Deep, so edits by the caller never reach the cached dictionaries
+    return inputs_.duplicate(true);
+}
+
+String DogeTransaction::script_address(const uint8_t* script, size_t len) const {
+    const uint8_t* hash = doge::p2pkh_script_hash(script, len);
+    if (!hash) {
+        return String();
+    }
+
+    doge::ParsedAddress address;
+    address.version = mainnet_ ? doge::ADDRESS_VERSION_MAINNET : doge::ADDRESS_VERSION_TESTNET;
+    memcpy(address.hash, hash, 20);
+    return String(doge::format_address(address).c_str());
+}
+
+Array DogeTransaction::get_outputs() {
+    if (!outputs_ready_) {
+        doge::TxOutputReader reader(view_);
+        doge::TxOutputView output;
+        while (reader.next(output)) {
+            Dictionary entry;
+            entry["value"] = static_cast<int64_t>(output.value);
+            entry["script_pubkey"] = to_packed(output.script_pubkey, output.script_pubkey_len);
+            entry["address"] = script_address(output.script_pubkey, output.script_pubkey_len);
+            outputs_.append(entry);
+        }
+        outputs_ready_ = true;
+    }
+    return outputs_.duplicate(true);
+}
+
+bool DogeTransaction::output_at(int index, doge::TxOutputView& output) const {
+    if (index < 0 || static_cast<uint64_t>(index) >= view_.output_count) {
+        UtilityFunctions::push_error(String("Output index out of range: ") + String::num_int64(index));
+        return false;
+    }
+
+    // One walk finds every output, so indexed reads in a loop stay linear
+    if (output_views_.empty()) {
+        output_views_.reserve(view_.output_count);
+        doge::TxOutputReader reader(view_);
+        doge::TxOutputView view;
+        while (reader.next(view)) {
+            output_views_.push_back(view);
+        }
+    }
+    output = output_views_[index];
+    return true;
+}
+
+int64_t DogeTransaction::get_output_value(int index) const {
+    doge::TxOutputView output;
+    return output_at(index, output) ? static_cast<int64_t>(output.value) : 0;
+}
+
+String DogeTransaction::get_output_address(int index) const {
+    doge::TxOutputView output;
+    return output_at(index, output) ? script_address(output.script_pubkey, output.script_pubkey_len) : String();
+}
+
+int64_t DogeTransaction::get_total_output() const {
+    uint64_t total = 0;
+    doge::TxOutputReader reader(view_);
+    doge::TxOutputView output;
+    while (reader.next(output)) {
+        total += output.value;
+    }
+    return static_cast<int64_t>(total);
+}
+
+PackedByteArray DogeTransaction::to_bytes() const {
+    return raw_;
+}
@@ -0,0 +1,75 @@
+#ifndef DOGE_TRANSACTION_CLASS_H
+#define DOGE_TRANSACTION_CLASS_H
+
+#include "crypto/transaction_view.h"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <vector>
+
+using namespace godot;
+
+// A raw transaction parsed in place. Construction validates the structure
+// and records offsets only; the txid, inputs and outputs are each built the
+// first time they are asked for, so reading the txid never decodes an
+// output. The bytes are shared with the array passed in, not copied.
+class DogeTransaction : public RefCounted {
+    GDCLASS(DogeTransaction, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    DogeTransaction();
+    ~DogeTransaction();
+
+    // mainnet selects the address form of output scripts
+    // Returns: null if the data is not a well-formed transaction
+    static Ref<DogeTransaction> from_bytes(const PackedByteArray& raw, bool mainnet = true);
+    static Ref<DogeTransaction> from_hex(const String& hex, bool mainnet = true);
+
+    // Byte-reversed hex, as shown by explorers and RPC
+    String get_txid();
+
+    int get_version() const;
+    int get_lock_time() const;
+    int get_size() const;
+    int get_input_count() const;
+    int get_output_count() const;
+
+    // Dictionaries of txid, vout, script_sig and sequence. Each call returns
+    // a fresh copy of the cached array.
+    Array get_inputs();
+
+    // Dictionaries of value (koinu), script_pubkey and address ("" if the
+    // script is not P2PKH), copied like get_inputs()
+    Array get_outputs();
+
+    // Single fields, decoded without building the output array
+    int64_t get_output_value(int index) const;
+    String get_output_address(int index) const;
+    int64_t get_total_output() const;
+
+    PackedByteArray to_bytes() const;
+
+private:
+    bool output_at(int index, doge::TxOutputView& output) const;
+    String script_address(const uint8_t* script, size_t len) const;
+
+    PackedByteArray raw_;
+    doge::TransactionView view_;
+    bool mainnet_ = true;
+
+    String txid_;
+    Array inputs_;
+    Array outputs_;
+    bool inputs_ready_ = false;
+    bool outputs_ready_ = false;
+    // Output spans into raw_, found on the first single-output read
+    mutable std::vector<doge::TxOutputView> output_views_;
+};
+
+#endif // DOGE_TRANSACTION_CLASS_H
@@ -0,0 +1,174 @@
+#include "doge_transaction_builder.h"
+#include "binding_utils.h"
+#include "crypto/address.h"
+#include "crypto/keypair.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+DogeTransactionBuilder::DogeTransactionBuilder() {
+}
+
+DogeTransactionBuilder::~DogeTransactionBuilder() {
+}
+
+void DogeTransactionBuilder::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_version", "version"), &DogeTransactionBuilder::set_version);
+    ClassDB::bind_method(D_METHOD("set_lock_time", "lock_time"), &DogeTransactionBuilder::set_lock_time);
+    ClassDB::bind_method(D_METHOD("add_input", "txid", "vout", "script_pubkey", "sequence"), &DogeTransactionBuilder::add_input, DEFVAL(PackedByteArray()), DEFVAL(0xffffffff));
+    ClassDB::bind_method(D_METHOD("add_output", "address", "amount"), &DogeTransactionBuilder::add_output);
+    ClassDB::bind_method(D_METHOD("add_output_script", "script_pubkey", "amount"), &DogeTransactionBuilder::add_output_script);
+    ClassDB::bind_method(D_METHOD("clear"), &DogeTransactionBuilder::clear);
+    ClassDB::bind_method(D_METHOD("sign", "keys"), &DogeTransactionBuilder::sign);
+    ClassDB::bind_method(D_METHOD("sign_input", "index", "key"), &DogeTransactionBuilder::sign_input);
+    ClassDB::bind_method(D_METHOD("get_signature_hash", "index", "script_pubkey"), &DogeTransactionBuilder::get_signature_hash);
+    ClassDB::bind_method(D_METHOD("to_bytes"), &DogeTransactionBuilder::to_bytes);
+    ClassDB::bind_method(D_METHOD("to_hex"), &DogeTransactionBuilder::to_hex);
+    ClassDB::bind_method(D_METHOD("get_txid"), &DogeTransactionBuilder::get_txid);
+    ClassDB::bind_method(D_METHOD("get_input_count"), &DogeTransactionBuilder::get_input_count);
+    ClassDB::bind_method(D_METHOD("get_output_count"), &DogeTransactionBuilder::get_output_count);
+    ClassDB::bind_method(D_METHOD("get_total_output"), &DogeTransactionBuilder::get_total_output);
+}
+
+void DogeTransactionBuilder::set_version(int version) {
+    builder_.set_version(static_cast<uint32_t>(version));
+}
+
+void DogeTransactionBuilder::set_lock_time(int lock_time) {
+    builder_.set_lock_time(static_cast<uint32_t>(lock_time));
+}
+
+int DogeTransactionBuilder::add_input(const String& txid, int vout, const PackedByteArray& script_pubkey, int64_t sequence) {
+    std::vector<uint8_t> txid_bytes;
+    if (!doge::hex_to_bytes(txid.utf8().get_data(), txid_bytes) || txid_bytes.size() != 32) {
+        UtilityFunctions::push_error(String("Invalid txid: ") + txid);
+        return -1;
+    }
+    if (vout < 0 || sequence < 0 || sequence > 0xffffffff) {
+        UtilityFunctions::push_error("Invalid input outpoint or sequence");
+        return -1;
+    }
+
+    // Serialized txids are the reverse of their display form
+    std::reverse(txid_bytes.begin(), txid_bytes.end());
+    size_t index = builder_.add_input(txid_bytes.data(), static_cast<uint32_t>(vout),
+                                      script_pubkey.ptr(), script_pubkey.size(), static_cast<uint32_t>(sequence));
+    return static_cast<int>(index);
+}
+
+int DogeTransactionBuilder::add_output(const String& address, int64_t amount) {
+    doge::ParsedAddress parsed;
+    if (!doge::parse_address(address.utf8().get_data(), parsed)) {
+        UtilityFunctions::push_error(String("Invalid Dogecoin address: ") + address);
+        return -1;
+    }
+    if (amount < 0) {
+        UtilityFunctions::push_error("Output amount must not be negative");
+        return -1;
+    }
+    return static_cast<int>(builder_.add_p2pkh_output(static_cast<uint64_t>(amount), parsed.hash));
+}
+
+int DogeTransactionBuilder::add_output_script(const PackedByteArray& script_pubkey, int64_t amount) {
+    if (amount < 0) {
+        UtilityFunctions::push_error("Output amount must not be negative");
+        return -1;
+    }
+    return static_cast<int>(builder_.add_output(static_cast<uint64_t>(amount), script_pubkey.ptr(), script_pubkey.size()));
+}
+
+void DogeTransactionBuilder::clear() {
+    builder_.clear();
+}
+
+bool DogeTransactionBuilder::sign(const Array& keys) {
+    size_t input_count = builder_.inputs().size();
+    if (keys.size() != 1 && static_cast<size_t>(keys.size()) != input_count) {
+        UtilityFunctions::push_error("Pass one signing key per input, or a single key for all inputs");
+        return false;
+    }
+
+    // The Ref array keeps every key alive while the pool signs
+    std::vector<Ref<DogeSigningKey>> refs(static_cast<size_t>(keys.size()));
+    for (int64_t i = 0; i < keys.size(); i++) {
+        refs[i] = keys[i];
+        if (refs[i].is_null()) {
+            UtilityFunctions::push_error("Signing keys must be DogeSigningKey instances");
+            return false;
+        }
+    }
+
+    std::vector<const doge::SigningKey*> key_ptrs(input_count);
+    for (size_t i = 0; i < input_count; i++) {
+        key_ptrs[i] = &refs[refs.size() == 1 ? 0 : i]->key_;
+    }
+
+    if (!builder_.sign(key_ptrs.data())) {
+        UtilityFunctions::push_error("Failed to sign transaction: a key does not match its input");
+        return false;
+    }
+    return true;
+}
+
+bool DogeTransactionBuilder::sign_input(int index, const Ref<DogeSigningKey>& key) {
+    if (key.is_null() || index < 0 || !builder_.sign_input(static_cast<size_t>(index), key->key_)) {
+        UtilityFunctions::push_error(String("Failed to sign input ") + String::num_int64(index));
+        return false;
+    }
+    return true;
+}
+
+PackedByteArray DogeTransactionBuilder::get_signature_hash(int index, const PackedByteArray& script_pubkey) {
+    PackedByteArray result;
+    uint8_t hash[32];
+    if (index < 0 || !builder_.signature_hash(static_cast<size_t>(index), script_pubkey.ptr(), script_pubkey.size(), hash)) {
+        UtilityFunctions::push_error(String("Input index out of range: ") + String::num_int64(index));
+        return result;
+    }
+
+    result.resize(32);
+    memcpy(result.ptrw(), hash, 32);
+    return result;
+}
+
+PackedByteArray DogeTransactionBuilder::to_bytes() const {
+    std::vector<uint8_t> raw;
+    builder_.serialize(raw);
+
+    PackedByteArray result;
+    result.resize(raw.size());
+    memcpy(result.ptrw(), raw.data(), raw.size());
+    return result;
+}
+
+String DogeTransactionBuilder::to_hex() const {
+    std::vector<uint8_t> raw;
+    builder_.serialize(raw);
+    return String(doge::bytes_to_hex(raw).c_str());
+}
+
+String DogeTransactionBuilder::get_txid() const {
+    uint8_t hash[32];
+    builder_.txid(hash);
+    return reversed_hex(hash);
+}
+
+int DogeTransactionBuilder::get_input_count() const {
+    return static_cast<int>(builder_.inputs().size());
+}
+
+int DogeTransactionBuilder::get_output_count() const {
+    return static_cast<int>(builder_.outputs().size());
+}
+
+int64_t DogeTransactionBuilder::get_total_output() const {
+    uint64_t total = 0;
+    for (const doge::TxOutput& output : builder_.outputs()) {
+        total += output.value;
+    }
+    return static_cast<int64_t>(total);
+}
@@ -0,0 +1,62 @@
+#ifndef DOGE_TRANSACTION_BUILDER_CLASS_H
+#define DOGE_TRANSACTION_BUILDER_CLASS_H
+
+#include "crypto/transaction.h"
+#include "doge_signing_key.h"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+using namespace godot;
+
+// Builds and signs legacy P2PKH transactions, producing raw bytes ready to
+// broadcast. Invariant parts of the transaction are serialized once and
+// shared by every input's signature hash, so large payouts sign quickly.
+class DogeTransactionBuilder : public RefCounted {
+    GDCLASS(DogeTransactionBuilder, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    DogeTransactionBuilder();
+    ~DogeTransactionBuilder();
+
+    void set_version(int version);
+    void set_lock_time(int lock_time);
+
+    // txid as shown by explorers and RPC (byte-reversed hex). An empty
+    // script_pubkey means the P2PKH script of the key that signs the input.
+    // Returns: index of the input, or -1 on an invalid txid
+    int add_input(const String& txid, int vout, const PackedByteArray& script_pubkey = PackedByteArray(), int64_t sequence = 0xffffffff);
+
+    // Amounts are in koinu (1 DOGE = 100,000,000 koinu)
+    // Returns: index of the output, or -1 on an invalid address or amount
+    int add_output(const String& address, int64_t amount);
+    int add_output_script(const PackedByteArray& script_pubkey, int64_t amount);
+
+    void clear();
+
+    // Sign every input: keys holds one DogeSigningKey per input, or a
+    // single key that signs them all
+    bool sign(const Array& keys);
+    bool sign_input(int index, const Ref<DogeSigningKey>& key);
+
+    // Legacy SIGHASH_ALL digest of an input, for signing elsewhere
+    PackedByteArray get_signature_hash(int index, const PackedByteArray& script_pubkey);
+
+    PackedByteArray to_bytes() const;
+    String to_hex() const;
+    String get_txid() const;
+
+    int get_input_count() const;
+    int get_output_count() const;
+    int64_t get_total_output() const;
+
+private:
+    doge::TransactionBuilder builder_;
+};
+
+#endif // DOGE_TRANSACTION_BUILDER_CLASS_H
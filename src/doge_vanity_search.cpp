@@ -0,0 +1,95 @@
+#include "doge_vanity_search.h"
+#include "crypto/keypair.h"
+#include "crypto/entropy.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cmath>
+
+DogeVanitySearch::DogeVanitySearch() {
+}
+
+DogeVanitySearch::~DogeVanitySearch() {
+}
+
+void DogeVanitySearch::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("start", "prefix", "mainnet", "compressed", "threads"), &DogeVanitySearch::start, DEFVAL(true), DEFVAL(true), DEFVAL(0));
+    ClassDB::bind_method(D_METHOD("cancel"), &DogeVanitySearch::cancel);
+    ClassDB::bind_method(D_METHOD("is_running"), &DogeVanitySearch::is_running);
+    ClassDB::bind_method(D_METHOD("is_found"), &DogeVanitySearch::is_found);
+    ClassDB::bind_method(D_METHOD("get_attempts"), &DogeVanitySearch::get_attempts);
+    ClassDB::bind_method(D_METHOD("get_keys_per_second"), &DogeVanitySearch::get_keys_per_second);
+    ClassDB::bind_method(D_METHOD("get_elapsed_seconds"), &DogeVanitySearch::get_elapsed_seconds);
+    ClassDB::bind_method(D_METHOD("get_expected_attempts"), &DogeVanitySearch::get_expected_attempts);
+    ClassDB::bind_method(D_METHOD("get_probability"), &DogeVanitySearch::get_probability);
+    ClassDB::bind_method(D_METHOD("get_result"), &DogeVanitySearch::get_result);
+}
+
+bool DogeVanitySearch::start(const String& prefix, bool mainnet, bool compressed, int threads) {
+    std::string error;
+    if (!search_.start(prefix.utf8().get_data(), mainnet, compressed,
+                       threads > 0 ? static_cast<size_t>(threads) : 0, error)) {
+        UtilityFunctions::push_error(String(error.c_str()));
+        return false;
+    }
+    mainnet_ = mainnet;
+    return true;
+}
+
+void DogeVanitySearch::cancel() {
+    search_.cancel();
+}
+
+bool DogeVanitySearch::is_running() const {
+    return search_.is_running();
+}
+
+bool DogeVanitySearch::is_found() const {
+    return search_.is_found();
+}
+
+int64_t DogeVanitySearch::get_attempts() const {
+    return static_cast<int64_t>(search_.attempts());
+}
+
+double DogeVanitySearch::get_keys_per_second() const {
+    return search_.keys_per_second();
+}
+
+double DogeVanitySearch::get_elapsed_seconds() const {
+    return search_.elapsed_seconds();
+}
+
+double DogeVanitySearch::get_expected_attempts() const {
+    return search_.expected_attempts();
+}
+
+double DogeVanitySearch::get_probability() const {
+    double expected = search_.expected_attempts();
+    if (expected <= 0) {
+        return 0.0;
+    }
+    return 1.0 - std::exp(-static_cast<double>(search_.attempts()) / expected);
+}
+
+Dictionary DogeVanitySearch::get_result() const {
+    Dictionary result;
+
+    std::vector<uint8_t> private_key;
+    std::vector<uint8_t> public_key;
+    std::string address;
+    if (!search_.result(private_key, public_key, address)) {
+        return result;
+    }
+
+    bool compressed = public_key.size() == 33;
+    std::string wif = doge::private_key_to_wif(private_key, compressed, mainnet_);
+    doge::secure_wipe(private_key.data(), private_key.size());
+
+    result["private_key"] = String(wif.c_str());
+    result["public_key"] = String(doge::bytes_to_hex(public_key).c_str());
+    result["address"] = String(address.c_str());
+
+    return result;
+}
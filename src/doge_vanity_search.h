@@ -0,0 +1,52 @@
+#ifndef DOGE_VANITY_SEARCH_H
+#define DOGE_VANITY_SEARCH_H
+
+#include "crypto/vanity.h"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+using namespace godot;
+
+// Background search for an address with a chosen prefix (e.g. "DGAME").
+// start() returns at once; poll the getters (from _process, say) for
+// progress and get_result() once is_found() is true.
+class DogeVanitySearch : public RefCounted {
+    GDCLASS(DogeVanitySearch, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    DogeVanitySearch();
+    ~DogeVanitySearch();
+
+    // threads = 0 uses one worker per CPU core
+    bool start(const String& prefix, bool mainnet = true, bool compressed = true, int threads = 0);
+
+    // Stop the workers and wait for them to exit
+    void cancel();
+
+    bool is_running() const;
+    bool is_found() const;
+
+    int64_t get_attempts() const;
+    double get_keys_per_second() const;
+    double get_elapsed_seconds() const;
+
+    // Mean number of keys needed for this prefix, and the chance that a
+    // match would have been found after the attempts made so far
+    double get_expected_attempts() const;
+    double get_probability() const;
+
+    // Returns: {private_key: String (WIF), public_key: String (hex), address: String}
+    // or an empty Dictionary before a match is found
+    Dictionary get_result() const;
+
+private:
+    doge::VanitySearch search_;
+    bool mainnet_ = true;
+};
+
+#endif // DOGE_VANITY_SEARCH_H
@@ -2,7 +2,15 @@
 #include "crypto/keypair.h"
 #include "crypto/address.h"
 #include "crypto/message_signer.h"
-
+#include "crypto/base58.h"
+#include "crypto/entropy.h"
+#include "crypto/merkle.h"
+#include "crypto/pow.h"
+#include "crypto/verify_cache.h"
+#include "utils/scrypt.h"
+#include "utils/thread_pool.h"
+
+#include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
@@ -14,6 +22,7 @@ DogeWallet::~DogeWallet() {
 
 void DogeWallet::_bind_methods() {
     ClassDB::bind_method(D_METHOD("generate_keypair", "compressed", "mainnet"), &DogeWallet::generate_keypair, DEFVAL(true), DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("generate_keypairs", "count", "compressed", "mainnet"), &DogeWallet::generate_keypairs, DEFVAL(true), DEFVAL(true));
     ClassDB::bind_method(D_METHOD("import_from_wif", "wif"), &DogeWallet::import_from_wif);
     ClassDB::bind_method(D_METHOD("export_to_wif", "private_key_hex", "compressed", "mainnet"), &DogeWallet::export_to_wif, DEFVAL(true), DEFVAL(true));
     ClassDB::bind_method(D_METHOD("get_address_from_public_key", "public_key_hex", "mainnet"), &DogeWallet::get_address_from_public_key, DEFVAL(true));
@@ -21,9 +30,30 @@ void DogeWallet::_bind_methods() {
     ClassDB::bind_method(D_METHOD("sign_message", "message", "private_key_hex", "compressed"), &DogeWallet::sign_message, DEFVAL(true));
     ClassDB::bind_method(D_METHOD("sign_message_wif", "message", "wif"), &DogeWallet::sign_message_wif);
     ClassDB::bind_method(D_METHOD("verify_message", "message", "signature_base64", "address"), &DogeWallet::verify_message);
+    ClassDB::bind_method(D_METHOD("verify_messages", "messages", "signatures", "addresses"), &DogeWallet::verify_messages);
+    ClassDB::bind_method(D_METHOD("configure_verify_cache", "capacity", "ttl_seconds"), &DogeWallet::configure_verify_cache, DEFVAL(0.0));
+    ClassDB::bind_method(D_METHOD("clear_verify_cache"), &DogeWallet::clear_verify_cache);
+    ClassDB::bind_method(D_METHOD("get_verify_cache_stats"), &DogeWallet::get_verify_cache_stats);
+    ClassDB::bind_method(D_METHOD("sign_bytes", "data", "wif"), &DogeWallet::sign_bytes);
+    ClassDB::bind_method(D_METHOD("verify_bytes", "data", "signature_base64", "address"), &DogeWallet::verify_bytes);
+    ClassDB::bind_method(D_METHOD("generate_keypair_async", "compressed", "mainnet"), &DogeWallet::generate_keypair_async, DEFVAL(true), DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("sign_message_wif_async", "message", "wif"), &DogeWallet::sign_message_wif_async);
+    ClassDB::bind_method(D_METHOD("verify_message_async", "message", "signature_base64", "address"), &DogeWallet::verify_message_async);
+    ClassDB::bind_method(D_METHOD("_drain_completed_jobs"), &DogeWallet::_drain_completed_jobs);
     ClassDB::bind_method(D_METHOD("validate_address", "address", "mainnet"), &DogeWallet::validate_address, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("scrypt_hash", "data"), &DogeWallet::scrypt_hash);
+    ClassDB::bind_method(D_METHOD("verify_headers_pow", "headers", "tx_counts"), &DogeWallet::verify_headers_pow, DEFVAL(false));
+    ClassDB::bind_method(D_METHOD("check_pow", "header", "bits"), &DogeWallet::check_pow);
+    ClassDB::bind_method(D_METHOD("compute_merkle_root", "txids"), &DogeWallet::compute_merkle_root);
+    ClassDB::bind_method(D_METHOD("verify_merkle_proof", "txid", "branch", "index", "root"), &DogeWallet::verify_merkle_proof);
+    ClassDB::bind_method(D_METHOD("verify_merkle_proofs", "txids", "branches", "indices", "roots"), &DogeWallet::verify_merkle_proofs);
+    ClassDB::bind_method(D_METHOD("random_bytes", "count"), &DogeWallet::random_bytes);
     ClassDB::bind_method(D_METHOD("bytes_to_hex", "bytes"), &DogeWallet::bytes_to_hex);
     ClassDB::bind_method(D_METHOD("hex_to_bytes", "hex"), &DogeWallet::hex_to_bytes);
+
+    ADD_SIGNAL(MethodInfo("job_completed",
+                          PropertyInfo(Variant::INT, "id"),
+                          PropertyInfo(Variant::NIL, "result", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NIL_IS_VARIANT)));
 }
 
 Dictionary DogeWallet::generate_keypair(bool compressed, bool mainnet) {
@@ -64,6 +94,53 @@ Dictionary DogeWallet::generate_keypair(bool compressed, bool mainnet) {
     return result;
 }
 
+Dictionary DogeWallet::generate_keypairs(int count, bool compressed, bool mainnet) {
+    Dictionary result;
+
+    if (count <= 0) {
+        UtilityFunctions::push_error("Keypair count must be positive");
+        return result;
+    }
+
+    size_t n = static_cast<size_t>(count);
+    size_t pubkey_len = compressed ? 33 : 65;
+
+    PackedByteArray private_keys;
+    PackedByteArray public_keys;
+    private_keys.resize(n * 32);
+    public_keys.resize(n * pubkey_len);
+    std::vector<uint8_t> pubkey_hashes(n * 20);
+
+    if (!doge::generate_keypairs(n, compressed, private_keys.ptrw(), public_keys.ptrw(), pubkey_hashes.data())) {
+        UtilityFunctions::push_error("Failed to generate keypairs");
+        return result;
+    }
+
+    uint8_t version = mainnet ? doge::ADDRESS_VERSION_MAINNET : doge::ADDRESS_VERSION_TESTNET;
+
+    PackedStringArray addresses;
+    addresses.resize(n);
+    String* addresses_w = addresses.ptrw();
+
+    doge::thread_pool().parallel_for(n, 256, [&](size_t begin, size_t end) {
+        uint8_t payload[21];
+        char buf[doge::base58_max_encoded_len(25) + 1];
+        payload[0] = version;
+
+        for (size_t i = begin; i < end; i++) {
+            memcpy(payload + 1, pubkey_hashes.data() + i * 20, 20);
+            buf[doge::base58check_encode_to(payload, 21, buf)] = '\0';
+            addresses_w[i] = String(buf);
+        }
+    });
+
+    result["private_keys"] = private_keys;
+    result["public_keys"] = public_keys;
+    result["addresses"] = addresses;
+
+    return result;
+}
+
 Dictionary DogeWallet::import_from_wif(const String& wif) {
     Dictionary result;
 
@@ -165,8 +242,9 @@ String DogeWallet::sign_message(const String& message, const String& private_key
         return String();
     }
 
-    std::string msg_str = message.utf8().get_data();
-    std::string signature = doge::sign_message(msg_str, private_key, compressed);
+    CharString msg_utf8 = message.utf8();
+    std::string signature = doge::sign_message(reinterpret_cast<const uint8_t*>(msg_utf8.get_data()),
+                                               msg_utf8.length(), private_key, compressed);
 
     if (signature.empty()) {
         UtilityFunctions::push_error("Failed to sign message");
@@ -187,8 +265,9 @@ String DogeWallet::sign_message_wif(const String& message, const String& wif) {
         return String();
     }
 
-    std::string msg_str = message.utf8().get_data();
-    std::string signature = doge::sign_message(msg_str, private_key, compressed);
+    CharString msg_utf8 = message.utf8();
+    std::string signature = doge::sign_message(reinterpret_cast<const uint8_t*>(msg_utf8.get_data()),
+                                               msg_utf8.length(), private_key, compressed);
 
     if (signature.empty()) {
         UtilityFunctions::push_error("Failed to sign message");
@@ -199,11 +278,175 @@ String DogeWallet::sign_message_wif(const String& message, const String& wif) {
 }
 
 bool DogeWallet::verify_message(const String& message, const String& signature_base64, const String& address) {
-    std::string msg_str = message.utf8().get_data();
+    CharString msg_utf8 = message.utf8();
+    std::string sig_str = signature_base64.utf8().get_data();
+    std::string addr_str = address.utf8().get_data();
+
+    return doge::verify_message(reinterpret_cast<const uint8_t*>(msg_utf8.get_data()), msg_utf8.length(),
+                                sig_str, addr_str);
+}
+
+PackedByteArray DogeWallet::verify_messages(const PackedStringArray& messages,
+                                            const PackedStringArray& signatures,
+                                            const PackedStringArray& addresses) {
+    PackedByteArray results;
+
+    int64_t count = messages.size();
+    if (signatures.size() != count || addresses.size() != count) {
+        UtilityFunctions::push_error("messages, signatures and addresses must have the same size");
+        return results;
+    }
+
+    // Convert once up front; the workers then never touch Godot types
+    std::vector<std::string> msg_strs(count);
+    std::vector<std::string> sig_strs(count);
+    std::vector<std::string> addr_strs(count);
+    for (int64_t i = 0; i < count; i++) {
+        CharString msg_utf8 = messages[i].utf8();
+        msg_strs[i].assign(msg_utf8.get_data(), msg_utf8.length());
+        sig_strs[i] = signatures[i].utf8().get_data();
+        addr_strs[i] = addresses[i].utf8().get_data();
+    }
+
+    results.resize(count);
+    doge::verify_messages(count, msg_strs.data(), sig_strs.data(), addr_strs.data(), results.ptrw());
+
+    return results;
+}
+
+void DogeWallet::configure_verify_cache(int capacity, double ttl_seconds) {
+    if (capacity < 0) {
+        UtilityFunctions::push_error("Cache capacity must not be negative");
+        return;
+    }
+    doge::verify_cache().configure(static_cast<size_t>(capacity), ttl_seconds);
+}
+
+void DogeWallet::clear_verify_cache() {
+    doge::verify_cache().clear();
+}
+
+Dictionary DogeWallet::get_verify_cache_stats() {
+    doge::VerifyCacheStats stats = doge::verify_cache().stats();
+
+    Dictionary result;
+    result["hits"] = static_cast<int64_t>(stats.hits);
+    result["misses"] = static_cast<int64_t>(stats.misses);
+    result["size"] = static_cast<int64_t>(stats.size);
+    result["capacity"] = static_cast<int64_t>(stats.capacity);
+    return result;
+}
+
+// Signed-message digest of a PackedByteArray, or of the rest of an open
+// FileAccess read in fixed-size chunks so memory use does not grow with it
+static bool hash_message_data(const Variant& data, uint8_t* hash) {
+    if (data.get_type() == Variant::PACKED_BYTE_ARRAY) {
+        PackedByteArray bytes = data;
+        doge::message_hash(bytes.ptr(), bytes.size(), hash);
+        return true;
+    }
+
+    Object* obj = data;
+    FileAccess* file = Object::cast_to<FileAccess>(obj);
+    if (!file) {
+        UtilityFunctions::push_error("Expected a PackedByteArray or an open FileAccess");
+        return false;
+    }
+
+    const uint64_t CHUNK_SIZE = 64 * 1024;
+    uint64_t remaining = file->get_length() - file->get_position();
+    doge::MessageHasher hasher(remaining);
+
+    while (remaining > 0) {
+        PackedByteArray chunk = file->get_buffer(remaining < CHUNK_SIZE ? remaining : CHUNK_SIZE);
+        if (chunk.is_empty()) {
+            UtilityFunctions::push_error("Failed to read file");
+            return false;
+        }
+        hasher.update(chunk.ptr(), chunk.size());
+        remaining -= chunk.size();
+    }
+
+    hasher.final(hash);
+    return true;
+}
+
+String DogeWallet::sign_bytes(const Variant& data, const String& wif) {
+    std::vector<uint8_t> private_key;
+    bool compressed;
+    bool mainnet;
+
+    std::string wif_str = wif.utf8().get_data();
+    if (!doge::wif_to_private_key(wif_str, private_key, compressed, mainnet)) {
+        UtilityFunctions::push_error("Invalid WIF private key");
+        return String();
+    }
+
+    uint8_t hash[32];
+    if (!hash_message_data(data, hash)) {
+        return String();
+    }
+
+    std::string signature = doge::sign_message_hash(hash, private_key, compressed);
+    if (signature.empty()) {
+        UtilityFunctions::push_error("Failed to sign data");
+        return String();
+    }
+
+    return String(signature.c_str());
+}
+
+bool DogeWallet::verify_bytes(const Variant& data, const String& signature_base64, const String& address) {
+    uint8_t hash[32];
+    if (!hash_message_data(data, hash)) {
+        return false;
+    }
+
     std::string sig_str = signature_base64.utf8().get_data();
     std::string addr_str = address.utf8().get_data();
 
-    return doge::verify_message(msg_str, sig_str, addr_str);
+    return doge::verify_message_hash(hash, sig_str, addr_str);
+}
+
+int64_t DogeWallet::generate_keypair_async(bool compressed, bool mainnet) {
+    return queue_job([this, compressed, mainnet]() -> Variant {
+        return generate_keypair(compressed, mainnet);
+    });
+}
+
+int64_t DogeWallet::sign_message_wif_async(const String& message, const String& wif) {
+    return queue_job([this, message, wif]() -> Variant {
+        return sign_message_wif(message, wif);
+    });
+}
+
+int64_t DogeWallet::verify_message_async(const String& message, const String& signature_base64, const String& address) {
+    return queue_job([this, message, signature_base64, address]() -> Variant {
+        return verify_message(message, signature_base64, address);
+    });
+}
+
+int64_t DogeWallet::queue_job(std::function<Variant()> work) {
+    int64_t id = next_job_id_.fetch_add(1, std::memory_order_relaxed);
+
+    // The task holds a reference so the wallet outlives its jobs. Only the
+    // push that finds the queue empty schedules a drain; that drain picks up
+    // everything finished before it runs, so a burst of jobs costs one
+    // deferred call per frame rather than one per job.
+    Ref<DogeWallet> self(this);
+    doge::thread_pool().submit([self, id, work]() {
+        if (self->completed_jobs_.push(CompletedJob{id, work()})) {
+            self->call_deferred("_drain_completed_jobs");
+        }
+    });
+
+    return id;
+}
+
+void DogeWallet::_drain_completed_jobs() {
+    completed_jobs_.drain([this](CompletedJob& job) {
+        emit_signal("job_completed", job.id, job.result);
+    });
 }
 
 bool DogeWallet::validate_address(const String& address, bool mainnet) {
@@ -211,6 +454,127 @@ bool DogeWallet::validate_address(const String& address, bool mainnet) {
     return doge::validate_address(addr_str, mainnet);
 }
 
+PackedByteArray DogeWallet::scrypt_hash(const PackedByteArray& data) {
+    PackedByteArray result;
+    result.resize(32);
+    doge::scrypt_1024_1_1(data.ptr(), data.size(), result.ptrw());
+    return result;
+}
+
+PackedByteArray DogeWallet::verify_headers_pow(const PackedByteArray& headers, bool tx_counts) {
+    std::vector<uint8_t> valid;
+    if (!doge::verify_headers_pow(headers.ptr(), headers.size(), valid, tx_counts)) {
+        UtilityFunctions::push_error("Headers are truncated or malformed");
+        return PackedByteArray();
+    }
+
+    PackedByteArray results;
+    results.resize(valid.size());
+    if (!valid.empty()) {
+        memcpy(results.ptrw(), valid.data(), valid.size());
+    }
+    return results;
+}
+
+bool DogeWallet::check_pow(const PackedByteArray& header, int64_t bits) {
+    if (header.size() != 80) {
+        UtilityFunctions::push_error("Header must be 80 bytes");
+        return false;
+    }
+    if (bits < 0 || bits > UINT32_MAX) {
+        return false;
+    }
+
+    uint8_t hash[32];
+    doge::header_pow_hash(header.ptr(), hash);
+    return doge::check_proof_of_work(hash, static_cast<uint32_t>(bits));
+}
+
+PackedByteArray DogeWallet::compute_merkle_root(const PackedByteArray& txids) {
+    if (txids.size() == 0 || txids.size() % 32 != 0) {
+        UtilityFunctions::push_error("txids must be a non-empty multiple of 32 bytes");
+        return PackedByteArray();
+    }
+
+    PackedByteArray root;
+    root.resize(32);
+    bool mutated;
+    doge::compute_merkle_root(txids.ptr(), txids.size() / 32, root.ptrw(), &mutated);
+    if (mutated) {
+        UtilityFunctions::push_error("Duplicate txids make this merkle root ambiguous");
+        return PackedByteArray();
+    }
+    return root;
+}
+
+bool DogeWallet::verify_merkle_proof(const PackedByteArray& txid, const PackedByteArray& branch, int64_t index,
+                                     const PackedByteArray& root) {
+    if (txid.size() != 32 || root.size() != 32 || branch.size() % 32 != 0) {
+        UtilityFunctions::push_error("txid and root must be 32 bytes and branch a multiple of 32 bytes");
+        return false;
+    }
+    if (index < 0 || index > UINT32_MAX) {
+        return false;
+    }
+    return doge::verify_merkle_proof(txid.ptr(), branch.ptr(), branch.size() / 32, static_cast<uint32_t>(index),
+                                     root.ptr());
+}
+
+PackedByteArray DogeWallet::verify_merkle_proofs(const PackedByteArray& txids, const Array& branches,
+                                                 const PackedInt64Array& indices, const PackedByteArray& roots) {
+    int64_t count = branches.size();
+    if (txids.size() != count * 32 || indices.size() != count ||
+        (roots.size() != 32 && roots.size() != count * 32)) {
+        UtilityFunctions::push_error("Expected 32 bytes of txid, one branch and one index per proof, and one root or one per proof");
+        return PackedByteArray();
+    }
+
+    // Hold the branch arrays so their data stays valid while workers read it
+    std::vector<PackedByteArray> branch_bytes(count);
+    std::vector<doge::MerkleProof> proofs(count);
+    std::vector<bool> usable(count);
+    for (int64_t i = 0; i < count; i++) {
+        branch_bytes[i] = branches[i];
+        int64_t index = indices[i];
+        usable[i] = branch_bytes[i].size() % 32 == 0 && index >= 0 && index <= UINT32_MAX;
+
+        doge::MerkleProof& proof = proofs[i];
+        proof.leaf = txids.ptr() + i * 32;
+        proof.branch = branch_bytes[i].ptr();
+        proof.depth = usable[i] ? branch_bytes[i].size() / 32 : 0;
+        proof.index = usable[i] ? static_cast<uint32_t>(index) : 0;
+        proof.root = roots.ptr() + (roots.size() == 32 ? 0 : i * 32);
+    }
+
+    PackedByteArray results;
+    results.resize(count);
+    uint8_t* results_w = results.ptrw();
+    doge::verify_merkle_proofs(proofs.data(), count, results_w);
+    for (int64_t i = 0; i < count; i++) {
+        if (!usable[i]) {
+            results_w[i] = 0;
+        }
+    }
+    return results;
+}
+
+PackedByteArray DogeWallet::random_bytes(int count) {
+    PackedByteArray result;
+
+    if (count < 0) {
+        UtilityFunctions::push_error("Byte count must not be negative");
+        return result;
+    }
+
+    result.resize(count);
+    if (!doge::random_bytes(result.ptrw(), static_cast<size_t>(count))) {
+        UtilityFunctions::push_error("Failed to read system entropy");
+        return PackedByteArray();
+    }
+
+    return result;
+}
+
 String DogeWallet::bytes_to_hex(const PackedByteArray& bytes) {
     std::vector<uint8_t> data(bytes.size());
     memcpy(data.data(), bytes.ptr(), bytes.size());
@@ -1,10 +1,18 @@
 #ifndef DOGE_WALLET_H
 #define DOGE_WALLET_H
 
+#include "utils/completion_queue.h"
+
 #include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
 #include <godot_cpp/variant/string.hpp>
 
+#include <atomic>
+#include <functional>
+
 using namespace godot;
 
 class DogeWallet : public RefCounted {
@@ -21,6 +29,12 @@ public:
     // Returns: {private_key: String (WIF), public_key: String (hex), address: String}
     Dictionary generate_keypair(bool compressed = true, bool mainnet = true);
 
+    // Generate many keypairs at once
+    // Returns: {private_keys: PackedByteArray (32 bytes each),
+    //           public_keys: PackedByteArray (33 or 65 bytes each),
+    //           addresses: PackedStringArray}
+    Dictionary generate_keypairs(int count, bool compressed = true, bool mainnet = true);
+
     // Import keypair from WIF private key
     // Returns: {private_key: String (WIF), public_key: String (hex), address: String}
     Dictionary import_from_wif(const String& wif);
@@ -43,12 +57,86 @@ public:
     // Verify a message signature
     bool verify_message(const String& message, const String& signature_base64, const String& address);
 
+    // Verify many signatures in one call, spread across all cores
+    // Returns: one byte per item, 1 if valid and 0 otherwise
+    PackedByteArray verify_messages(const PackedStringArray& messages,
+                                    const PackedStringArray& signatures,
+                                    const PackedStringArray& addresses);
+
+    // Cache recovered signers so resent signatures skip EC recovery.
+    // capacity 0 disables it (the default); ttl_seconds <= 0 means no expiry.
+    void configure_verify_cache(int capacity, double ttl_seconds = 0.0);
+    void clear_verify_cache();
+
+    // Returns: {hits: int, misses: int, size: int, capacity: int}
+    Dictionary get_verify_cache_stats();
+
+    // Sign / verify binary data: a PackedByteArray, or everything from the
+    // current position of an open FileAccess (streamed in constant memory)
+    String sign_bytes(const Variant& data, const String& wif);
+    bool verify_bytes(const Variant& data, const String& signature_base64, const String& address);
+
+    // Async variants: return a job id at once, do the work on the thread
+    // pool and emit job_completed(id, result) on the main thread, where
+    // result is what the synchronous method would have returned
+    int64_t generate_keypair_async(bool compressed = true, bool mainnet = true);
+    int64_t sign_message_wif_async(const String& message, const String& wif);
+    int64_t verify_message_async(const String& message, const String& signature_base64, const String& address);
+
     // Validate Dogecoin address format
     bool validate_address(const String& address, bool mainnet = true);
 
+    // scrypt(N=1024, r=1, p=1) of data with itself as salt: the PoW hash
+    // of an 80-byte block header. Returns 32 bytes, little-endian.
+    PackedByteArray scrypt_hash(const PackedByteArray& data);
+
+    // Check the PoW of serialized headers, each followed by its AuxPoW
+    // proof when merge-mined (and by a transaction count with tx_counts, as
+    // in a headers message), spread across all cores. A merge-mined header
+    // is checked through its parent header and the proof's commitment.
+    // Returns: one byte per header, 1 if valid and 0 otherwise
+    PackedByteArray verify_headers_pow(const PackedByteArray& headers, bool tx_counts = false);
+
+    // True if the scrypt hash of an 80-byte header meets the target in
+    // bits, e.g. an AuxPoW parent header against its child's nBits
+    bool check_pow(const PackedByteArray& header, int64_t bits);
+
+    // Merkle root of concatenated 32-byte txids in internal byte order (the
+    // reverse of display hex). Fails on a list whose root can be forged
+    // with duplicated txids (CVE-2012-2459).
+    PackedByteArray compute_merkle_root(const PackedByteArray& txids);
+
+    // Check that txid sits at position index under root, given the sibling
+    // hashes from the leaf level up (32 bytes each)
+    bool verify_merkle_proof(const PackedByteArray& txid, const PackedByteArray& branch, int64_t index,
+                             const PackedByteArray& root);
+
+    // Verify many proofs in one call, spread across all cores. txids holds
+    // 32 bytes per proof; roots holds 32 bytes per proof, or one root for all.
+    // Returns: one byte per proof, 1 if valid and 0 otherwise
+    PackedByteArray verify_merkle_proofs(const PackedByteArray& txids, const Array& branches,
+                                         const PackedInt64Array& indices, const PackedByteArray& roots);
+
+    // Cryptographically secure random bytes (for nonces, salts, IDs)
+    PackedByteArray random_bytes(int count);
+
     // Utility: Convert hex to bytes and vice versa
     String bytes_to_hex(const PackedByteArray& bytes);
     PackedByteArray hex_to_bytes(const String& hex);
+
+private:
+    struct CompletedJob {
+        int64_t id;
+        Variant result;
+    };
+
+    int64_t queue_job(std::function<Variant()> work);
+
+    // Emits job_completed for every finished job; deferred to the main thread
+    void _drain_completed_jobs();
+
+    doge::CompletionQueue<CompletedJob> completed_jobs_;
+    std::atomic<int64_t> next_job_id_{1};
 };
 
 #endif // DOGE_WALLET_H
@@ -1,5 +1,14 @@
 #include "register_types.h"
 #include "doge_wallet.h"
+#include "doge_signing_key.h"
+#include "doge_address.h"
+#include "doge_vanity_search.h"
+#include "doge_hd_wallet.h"
+#include "doge_address_index.h"
+#include "doge_keystore.h"
+#include "doge_transaction.h"
+#include "doge_transaction_builder.h"
+#include "doge_block_scanner.h"
 
 #include <gdextension_interface.h>
 #include <godot_cpp/core/defs.hpp>
@@ -13,6 +22,15 @@ void initialize_doge_wallet_module(ModuleInitializationLevel p_level) {
     }
 
     ClassDB::register_class<DogeWallet>();
+    ClassDB::register_class<DogeSigningKey>();
+    ClassDB::register_class<DogeAddress>();
+    ClassDB::register_class<DogeVanitySearch>();
+    ClassDB::register_class<DogeHDWallet>();
+    ClassDB::register_class<DogeAddressIndex>();
+    ClassDB::register_class<DogeKeystore>();
+    ClassDB::register_class<DogeTransactionBuilder>();
+    ClassDB::register_class<DogeTransaction>();
+    ClassDB::register_class<DogeBlockScanner>();
 }
 
 void uninitialize_doge_wallet_module(ModuleInitializationLevel p_level) {
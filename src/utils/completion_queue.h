@@ -0,0 +1,76 @@
+#ifndef DOGE_COMPLETION_QUEUE_H
+#define DOGE_COMPLETION_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace doge {
+
+// Lock-free multi-producer / single-consumer queue for handing finished
+// work back to one thread. Producers push onto an intrusive stack with a
+// CAS; the consumer takes the whole stack with one exchange, so there is no
+// ABA window, and reverses it to get completion order back.
+template <typename T>
+class CompletionQueue {
+public:
+    CompletionQueue() = default;
+    ~CompletionQueue() {
+        drain([](T&) {});
+    }
+
+    CompletionQueue(const CompletionQueue&) = delete;
+    CompletionQueue& operator=(const CompletionQueue&) = delete;
+
+    // Safe from any thread. Returns true if the queue was empty, i.e. this
+    // push is the one that should wake the consumer.
+    bool push(T value) {
+        // Once published the node belongs to the consumer, so the old head
+        // is tracked in a local rather than read back from node->next
+        Node* head = head_.load(std::memory_order_relaxed);
+        Node* node = new Node{std::move(value), head};
+        while (!head_.compare_exchange_weak(head, node,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+            node->next = head;
+        }
+        return head == nullptr;
+    }
+
+    // Consumer thread only. Calls fn on every queued item, oldest first,
+    // and returns how many there were.
+    template <typename Fn>
+    size_t drain(Fn&& fn) {
+        Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+
+        Node* ordered = nullptr;
+        while (node) {
+            Node* next = node->next;
+            node->next = ordered;
+            ordered = node;
+            node = next;
+        }
+
+        size_t count = 0;
+        while (ordered) {
+            Node* next = ordered->next;
+            fn(ordered->value);
+            delete ordered;
+            ordered = next;
+            count++;
+        }
+        return count;
+    }
+
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+
+    std::atomic<Node*> head_{nullptr};
+};
+
+} // namespace doge
+
+#endif // DOGE_COMPLETION_QUEUE_H
@@ -0,0 +1,101 @@
+#include "cpu_features.h"
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DOGE_CPU_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if (defined(__aarch64__) || defined(__arm__)) && (defined(__linux__) || defined(__ANDROID__))
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+#if defined(__aarch64__) && defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+namespace doge {
+
+#ifdef DOGE_CPU_X86
+static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; i++) {
+        regs[i] = static_cast<uint32_t>(r[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static uint64_t xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+static CpuFeatures detect_cpu_features() {
+    CpuFeatures f;
+
+#ifdef DOGE_CPU_X86
+    uint32_t regs[4];
+    cpuid(0, 0, regs);
+    uint32_t max_leaf = regs[0];
+
+    bool os_saves_ymm = false;
+
+    if (max_leaf >= 1) {
+        cpuid(1, 0, regs);
+        f.ssse3 = (regs[2] & (1u << 9)) != 0;
+        f.sse41 = (regs[2] & (1u << 19)) != 0;
+
+        // AVX registers are only usable if the OS saves them (OSXSAVE + XCR0)
+        bool osxsave = (regs[2] & (1u << 27)) != 0;
+        os_saves_ymm = osxsave && (xgetbv0() & 0x6) == 0x6;
+    }
+
+    if (max_leaf >= 7) {
+        cpuid(7, 0, regs);
+        f.sha_ni = (regs[1] & (1u << 29)) != 0;
+        f.avx2 = os_saves_ymm && (regs[1] & (1u << 5)) != 0;
+    }
+#elif defined(__aarch64__) && (defined(__linux__) || defined(__ANDROID__))
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    f.arm_sha2 = (hwcap & HWCAP_SHA2) != 0;
+#ifdef HWCAP_SHA512
+    f.arm_sha512 = (hwcap & HWCAP_SHA512) != 0;
+#endif
+#elif defined(__arm__) && (defined(__linux__) || defined(__ANDROID__))
+    unsigned long hwcap2 = getauxval(AT_HWCAP2);
+    f.arm_sha2 = (hwcap2 & HWCAP2_SHA2) != 0;
+#elif defined(__aarch64__) && defined(__APPLE__)
+    // Every Apple arm64 core implements the ARMv8 crypto extensions
+    f.arm_sha2 = true;
+
+    int sha512 = 0;
+    size_t size = sizeof(sha512);
+    if (sysctlbyname("hw.optional.armv8_2_sha512", &sha512, &size, nullptr, 0) == 0) {
+        f.arm_sha512 = sha512 != 0;
+    }
+#endif
+
+    return f;
+}
+
+const CpuFeatures& cpu_features() {
+    static const CpuFeatures features = detect_cpu_features();
+    return features;
+}
+
+} // namespace doge
@@ -0,0 +1,25 @@
+#ifndef DOGE_CPU_FEATURES_H
+#define DOGE_CPU_FEATURES_H
+
+namespace doge {
+
+// Instruction set extensions detected at runtime. Backends compiled with
+// extra ISA flags must only be called when the matching bit is set.
+struct CpuFeatures {
+    // x86
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sha_ni = false;
+    bool avx2 = false;
+
+    // ARM
+    bool arm_sha2 = false;
+    bool arm_sha512 = false; // ARMv8.2 SHA-512 (Cortex-A76+, Apple A13+)
+};
+
+// Probed once on first use, then cached (thread-safe)
+const CpuFeatures& cpu_features();
+
+} // namespace doge
+
+#endif // DOGE_CPU_FEATURES_H
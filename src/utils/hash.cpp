@@ -1,10 +1,13 @@
 #include "hash.h"
+#include "hash_backends.h"
+#include "cpu_features.h"
 #include <cstring>
 
 namespace doge {
 
 // SHA256 implementation (based on public domain code)
-static const uint32_t K[64] = {
+namespace detail {
+alignas(16) const uint32_t SHA256_K[64] = {
     0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
     0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
     0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
@@ -14,6 +17,7 @@ static const uint32_t K[64] = {
     0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
     0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
 };
+} // namespace detail
 
 #define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
 #define CH(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
@@ -23,7 +27,8 @@ static const uint32_t K[64] = {
 #define SIG0(x) (ROTR(x, 7) ^ ROTR(x, 18) ^ ((x) >> 3))
 #define SIG1(x) (ROTR(x, 17) ^ ROTR(x, 19) ^ ((x) >> 10))
 
-static void sha256_transform(uint32_t* state, const uint8_t* block) {
+static void sha256_transform_block(uint32_t* state, const uint8_t* block) {
+    const uint32_t* K = detail::SHA256_K;
     uint32_t a, b, c, d, e, f, g, h, t1, t2, m[64];
 
     for (int i = 0, j = 0; i < 16; i++, j += 4) {
@@ -48,20 +53,63 @@ static void sha256_transform(uint32_t* state, const uint8_t* block) {
     state[4] += e; state[5] += f; state[6] += g; state[7] += h;
 }
 
+// Portable fallback used when no hardware backend is available
+static void sha256_transform_scalar(uint32_t* state, const uint8_t* blocks, size_t nblocks) {
+    for (size_t i = 0; i < nblocks; i++) {
+        sha256_transform_block(state, blocks + i * 64);
+    }
+}
+
+static detail::Sha256TransformFn select_sha256_transform() {
+    const CpuFeatures& cpu = cpu_features();
+
+    if (cpu.sha_ni && cpu.sse41 && cpu.ssse3) {
+        if (detail::Sha256TransformFn fn = detail::sha256_transform_shani()) {
+            return fn;
+        }
+    }
+
+    if (cpu.arm_sha2) {
+        if (detail::Sha256TransformFn fn = detail::sha256_transform_armv8()) {
+            return fn;
+        }
+    }
+
+    return sha256_transform_scalar;
+}
+
+// Dispatch to the fastest backend, chosen once on first use
+static void sha256_transform(uint32_t* state, const uint8_t* blocks, size_t nblocks) {
+    static const detail::Sha256TransformFn transform = select_sha256_transform();
+    transform(state, blocks, nblocks);
+}
+
+static const uint32_t SHA256_INIT[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static void sha256_write_digest(const uint32_t* state, uint8_t* hash) {
+    for (int j = 0; j < 8; j++) {
+        hash[j * 4] = (state[j] >> 24) & 0xff;
+        hash[j * 4 + 1] = (state[j] >> 16) & 0xff;
+        hash[j * 4 + 2] = (state[j] >> 8) & 0xff;
+        hash[j * 4 + 3] = state[j] & 0xff;
+    }
+}
+
 void sha256(const uint8_t* data, size_t len, uint8_t* hash) {
-    uint32_t state[8] = {
-        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
-        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
-    };
+    uint32_t state[8];
+    memcpy(state, SHA256_INIT, sizeof(state));
 
     uint8_t block[64];
     size_t i = 0;
     uint64_t bitlen = len * 8;
 
     // Process full blocks
-    while (i + 64 <= len) {
-        sha256_transform(state, data + i);
-        i += 64;
+    if (len >= 64) {
+        i = len & ~static_cast<size_t>(63);
+        sha256_transform(state, data, len / 64);
     }
 
     // Handle remaining bytes
@@ -71,7 +119,7 @@ void sha256(const uint8_t* data, size_t len, uint8_t* hash) {
 
     if (rem > 56) {
         memset(block + rem, 0, 64 - rem);
-        sha256_transform(state, block);
+        sha256_transform(state, block, 1);
         rem = 0;
     }
 
@@ -82,31 +130,586 @@ void sha256(const uint8_t* data, size_t len, uint8_t* hash) {
         block[56 + j] = (bitlen >> (56 - j * 8)) & 0xff;
     }
 
-    sha256_transform(state, block);
+    sha256_transform(state, block, 1);
 
-    // Convert to bytes
-    for (int j = 0; j < 8; j++) {
-        hash[j * 4] = (state[j] >> 24) & 0xff;
-        hash[j * 4 + 1] = (state[j] >> 16) & 0xff;
-        hash[j * 4 + 2] = (state[j] >> 8) & 0xff;
-        hash[j * 4 + 3] = state[j] & 0xff;
-    }
+    sha256_write_digest(state, hash);
 }
 
 void sha256(const std::vector<uint8_t>& data, uint8_t* hash) {
     sha256(data.data(), data.size(), hash);
 }
 
+void Sha256Ctx::init() {
+    memcpy(state, SHA256_INIT, sizeof(state));
+    length = 0;
+}
+
+void Sha256Ctx::update(const uint8_t* data, size_t len) {
+    if (len == 0) {
+        return;
+    }
+
+    size_t fill = length % 64;
+    length += len;
+
+    // Top up a partially filled block first
+    if (fill > 0) {
+        size_t take = 64 - fill < len ? 64 - fill : len;
+        memcpy(buffer + fill, data, take);
+        data += take;
+        len -= take;
+        if (fill + take < 64) {
+            return;
+        }
+        sha256_transform(state, buffer, 1);
+    }
+
+    // Whole blocks straight from the input
+    if (len >= 64) {
+        sha256_transform(state, data, len / 64);
+        data += len & ~static_cast<size_t>(63);
+        len &= 63;
+    }
+
+    memcpy(buffer, data, len);
+}
+
+void Sha256Ctx::final(uint8_t* hash) {
+    uint64_t bitlen = length * 8;
+    size_t fill = length % 64;
+
+    buffer[fill++] = 0x80;
+    if (fill > 56) {
+        memset(buffer + fill, 0, 64 - fill);
+        sha256_transform(state, buffer, 1);
+        fill = 0;
+    }
+    memset(buffer + fill, 0, 56 - fill);
+
+    for (int j = 0; j < 8; j++) {
+        buffer[56 + j] = (bitlen >> (56 - j * 8)) & 0xff;
+    }
+    sha256_transform(state, buffer, 1);
+
+    sha256_write_digest(state, hash);
+}
+
+// Compile-time tail of an N-byte SHA-256 message: 0x80, zero fill and the
+// big-endian bit length, spread over the last one or two blocks
+template <size_t N>
+struct Sha256FixedTail {
+    static constexpr size_t FULL = N / 64;
+    static constexpr size_t REM = N % 64;
+    static constexpr size_t SIZE = REM < 56 ? 64 : 128;
+
+    struct Bytes {
+        uint8_t b[SIZE];
+    };
+
+    static constexpr Bytes make() {
+        Bytes t{};
+        t.b[REM] = 0x80;
+        for (size_t j = 0; j < 8; j++) {
+            t.b[SIZE - 1 - j] = static_cast<uint8_t>((static_cast<uint64_t>(N) * 8) >> (j * 8));
+        }
+        return t;
+    }
+
+    static constexpr Bytes padding = make();
+};
+
+template <size_t N>
+void sha256_fixed(const uint8_t* data, uint8_t* hash) {
+    typedef Sha256FixedTail<N> Tail;
+    uint32_t state[8];
+    memcpy(state, SHA256_INIT, sizeof(state));
+
+    if (Tail::FULL > 0) {
+        sha256_transform(state, data, Tail::FULL);
+    }
+
+    uint8_t block[Tail::SIZE];
+    memcpy(block, Tail::padding.b, Tail::SIZE);
+    memcpy(block, data + Tail::FULL * 64, Tail::REM);
+    sha256_transform(state, block, Tail::SIZE / 64);
+
+    sha256_write_digest(state, hash);
+}
+
+template <size_t N>
+void sha256_double_fixed(const uint8_t* data, uint8_t* hash) {
+    uint8_t temp[32];
+    sha256_fixed<N>(data, temp);
+    sha256_fixed<32>(temp, hash);
+}
+
+template void sha256_fixed<21>(const uint8_t*, uint8_t*);
+template void sha256_fixed<32>(const uint8_t*, uint8_t*);
+template void sha256_fixed<33>(const uint8_t*, uint8_t*);
+template void sha256_fixed<34>(const uint8_t*, uint8_t*);
+template void sha256_fixed<64>(const uint8_t*, uint8_t*);
+template void sha256_fixed<65>(const uint8_t*, uint8_t*);
+
+template void sha256_double_fixed<21>(const uint8_t*, uint8_t*);
+template void sha256_double_fixed<32>(const uint8_t*, uint8_t*);
+template void sha256_double_fixed<33>(const uint8_t*, uint8_t*);
+template void sha256_double_fixed<34>(const uint8_t*, uint8_t*);
+template void sha256_double_fixed<64>(const uint8_t*, uint8_t*);
+template void sha256_double_fixed<65>(const uint8_t*, uint8_t*);
+template void sha256_double_fixed<80>(const uint8_t*, uint8_t*);
+
 void sha256_double(const uint8_t* data, size_t len, uint8_t* hash) {
     uint8_t temp[32];
     sha256(data, len, temp);
-    sha256(temp, 32, hash);
+    sha256_fixed<32>(temp, hash);
 }
 
 void sha256_double(const std::vector<uint8_t>& data, uint8_t* hash) {
     sha256_double(data.data(), data.size(), hash);
 }
 
+// Multi-buffer backend for sha256_many. 8 AVX2 lanes outrun SHA-NI on short
+// messages, but 4-lane SSE2/NEON lose to a single-stream hardware backend,
+// so those are only used when SHA-NI / ARMv8 SHA2 is missing.
+static detail::Sha256LanesBackend select_sha256_lanes() {
+    const CpuFeatures& cpu = cpu_features();
+    detail::Sha256LanesBackend none{nullptr, 0};
+
+    if (cpu.avx2) {
+        detail::Sha256LanesBackend avx2 = detail::sha256_lanes_avx2();
+        if (avx2.fn) {
+            return avx2;
+        }
+    }
+
+    if ((cpu.sha_ni && cpu.sse41 && cpu.ssse3 && detail::sha256_transform_shani()) ||
+        (cpu.arm_sha2 && detail::sha256_transform_armv8())) {
+        return none;
+    }
+
+    detail::Sha256LanesBackend sse2 = detail::sha256_lanes_sse2();
+    if (sse2.fn) {
+        return sse2;
+    }
+
+    detail::Sha256LanesBackend neon = detail::sha256_lanes_neon();
+    if (neon.fn) {
+        return neon;
+    }
+
+    return none;
+}
+
+static void sha256_many(const uint8_t* data, size_t len, size_t count, uint8_t* hashes,
+                        bool double_hash) {
+    static const detail::Sha256LanesBackend lanes = select_sha256_lanes();
+    size_t i = 0;
+
+    if (lanes.fn) {
+        for (; i + lanes.lanes <= count; i += lanes.lanes) {
+            lanes.fn(data + i * len, len, hashes + i * 32, double_hash);
+        }
+    }
+
+    // Scalar tail (or everything, when a single-stream backend is faster)
+    for (; i < count; i++) {
+        if (double_hash) {
+            sha256_double(data + i * len, len, hashes + i * 32);
+        } else {
+            sha256(data + i * len, len, hashes + i * 32);
+        }
+    }
+}
+
+void sha256_many(const uint8_t* data, size_t len, size_t count, uint8_t* hashes) {
+    sha256_many(data, len, count, hashes, false);
+}
+
+void sha256_double_many(const uint8_t* data, size_t len, size_t count, uint8_t* hashes) {
+    sha256_many(data, len, count, hashes, true);
+}
+
+// SHA512 implementation
+namespace detail {
+alignas(16) const uint64_t SHA512_K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+} // namespace detail
+
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+#define S512_0(x) (ROTR64(x, 28) ^ ROTR64(x, 34) ^ ROTR64(x, 39))
+#define S512_1(x) (ROTR64(x, 14) ^ ROTR64(x, 18) ^ ROTR64(x, 41))
+#define G512_0(x) (ROTR64(x, 1) ^ ROTR64(x, 8) ^ ((x) >> 7))
+#define G512_1(x) (ROTR64(x, 19) ^ ROTR64(x, 61) ^ ((x) >> 6))
+
+static inline uint64_t load_be64(const uint8_t* p) {
+    uint64_t w;
+    memcpy(&w, p, 8);
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(w);
+#else
+    w = ((w & 0x00ff00ff00ff00ffULL) << 8) | ((w >> 8) & 0x00ff00ff00ff00ffULL);
+    w = ((w & 0x0000ffff0000ffffULL) << 16) | ((w >> 16) & 0x0000ffff0000ffffULL);
+    return (w << 32) | (w >> 32);
+#endif
+}
+
+// Portable fallback used when no hardware backend is available. On x86-64
+// this is also the fastest choice: a lone SHA-512 stream is one serial
+// dependency chain, so wider SIMD has nothing to run in parallel.
+static void sha512_transform_scalar(uint64_t* state, const uint8_t* blocks, size_t nblocks) {
+    const uint64_t* K = detail::SHA512_K;
+    uint64_t a, b, c, d, e, f, g, h, t1, t2, m[80];
+
+    for (size_t n = 0; n < nblocks; n++) {
+        const uint8_t* block = blocks + n * 128;
+
+        for (int i = 0; i < 16; i++) {
+            m[i] = load_be64(block + i * 8);
+        }
+
+        for (int i = 16; i < 80; i++) {
+            m[i] = G512_1(m[i - 2]) + m[i - 7] + G512_0(m[i - 15]) + m[i - 16];
+        }
+
+        a = state[0]; b = state[1]; c = state[2]; d = state[3];
+        e = state[4]; f = state[5]; g = state[6]; h = state[7];
+
+        for (int i = 0; i < 80; i++) {
+            t1 = h + S512_1(e) + CH(e, f, g) + K[i] + m[i];
+            t2 = S512_0(a) + MAJ(a, b, c);
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+static detail::Sha512TransformFn select_sha512_transform() {
+    if (cpu_features().arm_sha512) {
+        if (detail::Sha512TransformFn fn = detail::sha512_transform_armv8()) {
+            return fn;
+        }
+    }
+    return sha512_transform_scalar;
+}
+
+static void sha512_transform(uint64_t* state, const uint8_t* blocks, size_t nblocks) {
+    static const detail::Sha512TransformFn transform = select_sha512_transform();
+    transform(state, blocks, nblocks);
+}
+
+static const uint64_t SHA512_INIT[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+void Sha512Ctx::init() {
+    memcpy(state, SHA512_INIT, sizeof(state));
+    length = 0;
+}
+
+void Sha512Ctx::update(const uint8_t* data, size_t len) {
+    if (len == 0) {
+        return;
+    }
+
+    size_t fill = length % 128;
+    length += len;
+
+    // Top up a partially filled block first
+    if (fill > 0) {
+        size_t take = 128 - fill < len ? 128 - fill : len;
+        memcpy(buffer + fill, data, take);
+        data += take;
+        len -= take;
+        if (fill + take < 128) {
+            return;
+        }
+        sha512_transform(state, buffer, 1);
+    }
+
+    // Whole blocks straight from the input
+    if (len >= 128) {
+        sha512_transform(state, data, len / 128);
+        data += len & ~static_cast<size_t>(127);
+        len &= 127;
+    }
+
+    memcpy(buffer, data, len);
+}
+
+void Sha512Ctx::final(uint8_t* hash) {
+    uint64_t bitlen = length * 8;
+    size_t fill = length % 128;
+
+    // 128-bit length field; messages here never reach 2^64 bits, so the
+    // high half is zero
+    buffer[fill++] = 0x80;
+    if (fill > 112) {
+        memset(buffer + fill, 0, 128 - fill);
+        sha512_transform(state, buffer, 1);
+        fill = 0;
+    }
+    memset(buffer + fill, 0, 120 - fill);
+
+    for (int j = 0; j < 8; j++) {
+        buffer[120 + j] = (bitlen >> (56 - j * 8)) & 0xff;
+    }
+    sha512_transform(state, buffer, 1);
+
+    for (int j = 0; j < 8; j++) {
+        for (int k = 0; k < 8; k++) {
+            hash[j * 8 + k] = (state[j] >> (56 - k * 8)) & 0xff;
+        }
+    }
+}
+
+void sha512(const uint8_t* data, size_t len, uint8_t* hash) {
+    Sha512Ctx ctx;
+    ctx.update(data, len);
+    ctx.final(hash);
+}
+
+// Clear key-derived state without the compiler dropping the stores
+static void wipe(void* data, size_t len) {
+    volatile uint8_t* p = static_cast<volatile uint8_t*>(data);
+    while (len--) {
+        *p++ = 0;
+    }
+}
+
+HmacSha512::HmacSha512(const uint8_t* key, size_t key_len) {
+    // Keys longer than a block are hashed first
+    uint8_t block[128] = {};
+    if (key_len > 128) {
+        sha512(key, key_len, block);
+    } else {
+        memcpy(block, key, key_len);
+    }
+
+    uint8_t pad[128];
+    for (int i = 0; i < 128; i++) {
+        pad[i] = block[i] ^ 0x36;
+    }
+    inner_.update(pad, 128);
+
+    for (int i = 0; i < 128; i++) {
+        pad[i] = block[i] ^ 0x5c;
+    }
+    outer_.update(pad, 128);
+
+    wipe(block, sizeof(block));
+    wipe(pad, sizeof(pad));
+}
+
+HmacSha512::~HmacSha512() {
+    wipe(&inner_, sizeof(inner_));
+    wipe(&outer_, sizeof(outer_));
+}
+
+void HmacSha512::mac(const uint8_t* data, size_t len, uint8_t* out) const {
+    uint8_t inner_hash[64];
+
+    Sha512Ctx ctx = inner_;
+    ctx.update(data, len);
+    ctx.final(inner_hash);
+
+    ctx = outer_;
+    ctx.update(inner_hash, 64);
+    ctx.final(out);
+
+    wipe(&ctx, sizeof(ctx));
+}
+
+void hmac_sha512(const uint8_t* key, size_t key_len,
+                 const uint8_t* data, size_t len, uint8_t* out) {
+    HmacSha512(key, key_len).mac(data, len, out);
+}
+
+HmacSha256::HmacSha256(const uint8_t* key, size_t key_len) {
+    // Keys longer than a block are hashed first
+    uint8_t block[64] = {};
+    if (key_len > 64) {
+        sha256(key, key_len, block);
+    } else {
+        memcpy(block, key, key_len);
+    }
+
+    uint8_t pad[64];
+    for (int i = 0; i < 64; i++) {
+        pad[i] = block[i] ^ 0x36;
+    }
+    inner_.update(pad, 64);
+
+    for (int i = 0; i < 64; i++) {
+        pad[i] = block[i] ^ 0x5c;
+    }
+    outer_.update(pad, 64);
+
+    wipe(block, sizeof(block));
+    wipe(pad, sizeof(pad));
+}
+
+HmacSha256::~HmacSha256() {
+    wipe(&inner_, sizeof(inner_));
+    wipe(&outer_, sizeof(outer_));
+}
+
+void HmacSha256::mac(const uint8_t* data, size_t len, uint8_t* out) const {
+    uint8_t inner_hash[32];
+
+    Sha256Ctx ctx = inner_;
+    ctx.update(data, len);
+    ctx.final(inner_hash);
+
+    ctx = outer_;
+    ctx.update(inner_hash, 32);
+    ctx.final(out);
+
+    wipe(&ctx, sizeof(ctx));
+}
+
+void pbkdf2_hmac_sha256(const uint8_t* password, size_t password_len,
+                        const uint8_t* salt, size_t salt_len,
+                        uint32_t iterations, uint8_t* out, size_t out_len) {
+    HmacSha256 hmac(password, password_len);
+
+    // Every output block hashes the same salt before its index
+    Sha256Ctx salted = hmac.inner_;
+    salted.update(salt, salt_len);
+
+    uint8_t u[32];
+    uint8_t acc[32];
+    for (uint32_t index = 1; out_len > 0; index++) {
+        // U_1 = HMAC(password, salt || INT(index))
+        uint8_t be_index[4] = {
+            static_cast<uint8_t>(index >> 24), static_cast<uint8_t>(index >> 16),
+            static_cast<uint8_t>(index >> 8), static_cast<uint8_t>(index)
+        };
+        Sha256Ctx ctx = salted;
+        ctx.update(be_index, 4);
+        ctx.final(u);
+        ctx = hmac.outer_;
+        ctx.update(u, 32);
+        ctx.final(u);
+        memcpy(acc, u, 32);
+
+        // U_n = HMAC(password, U_n-1), folded into acc
+        for (uint32_t n = 1; n < iterations; n++) {
+            hmac.mac(u, 32, u);
+            for (int j = 0; j < 32; j++) {
+                acc[j] ^= u[j];
+            }
+        }
+
+        size_t take = out_len < 32 ? out_len : 32;
+        memcpy(out, acc, take);
+        out += take;
+        out_len -= take;
+
+        wipe(&ctx, sizeof(ctx));
+    }
+
+    wipe(&salted, sizeof(salted));
+    wipe(u, sizeof(u));
+    wipe(acc, sizeof(acc));
+}
+
+static inline void store_be64(uint8_t* p, uint64_t w) {
+    for (int k = 0; k < 8; k++) {
+        p[k] = static_cast<uint8_t>(w >> (56 - k * 8));
+    }
+}
+
+void pbkdf2_hmac_sha512(const uint8_t* password, size_t password_len,
+                        const uint8_t* salt, size_t salt_len,
+                        uint32_t iterations, uint8_t* out, size_t out_len) {
+    HmacSha512 hmac(password, password_len);
+
+    // Both hashes of an iteration process a 64-byte message after a
+    // 128-byte pad block, so they share one padded block: the message,
+    // 0x80, zeros and the bit length (192 * 8 = 0x600)
+    uint8_t block[128] = {};
+    block[64] = 0x80;
+    block[126] = 0x06;
+
+    uint64_t state[8];
+    uint64_t acc[8];
+
+    for (uint32_t index = 1; out_len > 0; index++) {
+        // U_1 = HMAC(password, salt || INT(index))
+        uint8_t be_index[4] = {
+            static_cast<uint8_t>(index >> 24), static_cast<uint8_t>(index >> 16),
+            static_cast<uint8_t>(index >> 8), static_cast<uint8_t>(index)
+        };
+        Sha512Ctx ctx = hmac.inner_;
+        ctx.update(salt, salt_len);
+        ctx.update(be_index, 4);
+        ctx.final(block);
+        ctx = hmac.outer_;
+        ctx.update(block, 64);
+        ctx.final(block);
+
+        for (int j = 0; j < 8; j++) {
+            acc[j] = load_be64(block + j * 8);
+        }
+
+        // U_n = HMAC(password, U_n-1), folded into acc
+        for (uint32_t n = 1; n < iterations; n++) {
+            memcpy(state, hmac.inner_.state, sizeof(state));
+            sha512_transform(state, block, 1);
+            for (int j = 0; j < 8; j++) {
+                store_be64(block + j * 8, state[j]);
+            }
+
+            memcpy(state, hmac.outer_.state, sizeof(state));
+            sha512_transform(state, block, 1);
+            for (int j = 0; j < 8; j++) {
+                store_be64(block + j * 8, state[j]);
+                acc[j] ^= state[j];
+            }
+        }
+
+        uint8_t derived[64];
+        for (int j = 0; j < 8; j++) {
+            store_be64(derived + j * 8, acc[j]);
+        }
+        size_t take = out_len < 64 ? out_len : 64;
+        memcpy(out, derived, take);
+        out += take;
+        out_len -= take;
+
+        wipe(derived, sizeof(derived));
+        wipe(&ctx, sizeof(ctx));
+    }
+
+    wipe(block, sizeof(block));
+    wipe(state, sizeof(state));
+    wipe(acc, sizeof(acc));
+}
+
 // RIPEMD160 implementation (based on public domain code)
 #define ROL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
 
@@ -269,14 +872,100 @@ void ripemd160(const std::vector<uint8_t>& data, uint8_t* hash) {
     ripemd160(data.data(), data.size(), hash);
 }
 
+// RIPEMD160 of exactly 32 bytes (the second half of hash160): a single block
+// whose padding and 256-bit length are constant
+static void ripemd160_32(const uint8_t* data, uint8_t* hash) {
+    static const uint8_t PADDING[32] = {
+        0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0x00, 0x01, 0, 0, 0, 0, 0, 0
+    };
+    uint32_t state[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+
+    uint8_t block[64];
+    memcpy(block, data, 32);
+    memcpy(block + 32, PADDING, 32);
+    ripemd160_transform(state, block);
+
+    for (int j = 0; j < 5; j++) {
+        hash[j * 4] = state[j] & 0xff;
+        hash[j * 4 + 1] = (state[j] >> 8) & 0xff;
+        hash[j * 4 + 2] = (state[j] >> 16) & 0xff;
+        hash[j * 4 + 3] = (state[j] >> 24) & 0xff;
+    }
+}
+
+template <size_t N>
+void hash160_fixed(const uint8_t* data, uint8_t* hash) {
+    uint8_t sha_hash[32];
+    sha256_fixed<N>(data, sha_hash);
+    ripemd160_32(sha_hash, hash);
+}
+
+template void hash160_fixed<33>(const uint8_t*, uint8_t*);
+template void hash160_fixed<65>(const uint8_t*, uint8_t*);
+
 void hash160(const uint8_t* data, size_t len, uint8_t* hash) {
+    // Pubkeys are the only shapes that matter in practice
+    if (len == 33) {
+        hash160_fixed<33>(data, hash);
+        return;
+    }
+    if (len == 65) {
+        hash160_fixed<65>(data, hash);
+        return;
+    }
+
     uint8_t sha_hash[32];
     sha256(data, len, sha_hash);
-    ripemd160(sha_hash, 32, hash);
+    ripemd160_32(sha_hash, hash);
 }
 
 void hash160(const std::vector<uint8_t>& data, uint8_t* hash) {
     hash160(data.data(), data.size(), hash);
 }
 
+// There is no RIPEMD-160 instruction anywhere, so SIMD lanes always win
+static detail::Ripemd160LanesBackend select_ripemd160_lanes() {
+    if (cpu_features().avx2) {
+        detail::Ripemd160LanesBackend avx2 = detail::ripemd160_32_lanes_avx2();
+        if (avx2.fn) {
+            return avx2;
+        }
+    }
+
+    detail::Ripemd160LanesBackend sse2 = detail::ripemd160_32_lanes_sse2();
+    if (sse2.fn) {
+        return sse2;
+    }
+
+    return detail::ripemd160_32_lanes_neon();
+}
+
+static void ripemd160_32_many(const uint8_t* digests, size_t count, uint8_t* hashes) {
+    static const detail::Ripemd160LanesBackend lanes = select_ripemd160_lanes();
+    size_t i = 0;
+
+    if (lanes.fn) {
+        for (; i + lanes.lanes <= count; i += lanes.lanes) {
+            lanes.fn(digests + i * 32, hashes + i * 20);
+        }
+    }
+
+    for (; i < count; i++) {
+        ripemd160(digests + i * 32, 32, hashes + i * 20);
+    }
+}
+
+void hash160_many(const uint8_t* data, size_t len, size_t count, uint8_t* hashes) {
+    // Work in chunks so the intermediate SHA-256 digests stay on the stack
+    const size_t CHUNK = 64;
+    uint8_t digests[CHUNK * 32];
+
+    for (size_t i = 0; i < count; i += CHUNK) {
+        size_t n = count - i < CHUNK ? count - i : CHUNK;
+        sha256_many(data + i * len, len, n, digests);
+        ripemd160_32_many(digests, n, hashes + i * 20);
+    }
+}
+
 } // namespace doge
@@ -1,6 +1,7 @@
 #ifndef DOGE_HASH_H
 #define DOGE_HASH_H
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -14,6 +15,100 @@ void sha256(const std::vector<uint8_t>& data, uint8_t* hash);
 void sha256_double(const uint8_t* data, size_t len, uint8_t* hash);
 void sha256_double(const std::vector<uint8_t>& data, uint8_t* hash);
 
+// Incremental SHA256 for data that arrives in pieces (message envelopes,
+// file streams) so it never has to be concatenated in memory
+struct Sha256Ctx {
+    uint32_t state[8];
+    uint8_t buffer[64];
+    uint64_t length; // bytes consumed so far
+
+    Sha256Ctx() { init(); }
+
+    void init();
+    void update(const uint8_t* data, size_t len);
+    void final(uint8_t* hash); // writes 32 bytes; call init() to reuse
+};
+
+// HMAC-SHA256 with the key's pad blocks absorbed once, as HmacSha512
+class HmacSha256 {
+public:
+    HmacSha256(const uint8_t* key, size_t key_len);
+    ~HmacSha256();
+
+    void mac(const uint8_t* data, size_t len, uint8_t* out) const; // writes 32 bytes
+
+private:
+    friend void pbkdf2_hmac_sha256(const uint8_t*, size_t, const uint8_t*, size_t,
+                                   uint32_t, uint8_t*, size_t);
+
+    Sha256Ctx inner_;
+    Sha256Ctx outer_;
+};
+
+// PBKDF2-HMAC-SHA256 (scrypt's outer layers). The salt is absorbed into
+// the inner state once and shared by every output block.
+void pbkdf2_hmac_sha256(const uint8_t* password, size_t password_len,
+                        const uint8_t* salt, size_t salt_len,
+                        uint32_t iterations, uint8_t* out, size_t out_len);
+
+// Fixed-length variants for the hottest shapes, with padding and length
+// words computed at compile time. Instantiated in hash.cpp for:
+//   sha256_fixed / sha256_double_fixed: N = 21, 32, 33, 34, 64, 65
+//   sha256_double_fixed: N = 80 (block headers)
+//   hash160_fixed: N = 33, 65
+template <size_t N> void sha256_fixed(const uint8_t* data, uint8_t* hash);
+template <size_t N> void sha256_double_fixed(const uint8_t* data, uint8_t* hash);
+template <size_t N> void hash160_fixed(const uint8_t* data, uint8_t* hash);
+
+// Batch SHA256 / double SHA256 of `count` independent messages, each `len`
+// bytes long and stored back to back in `data`. Writes count * 32 bytes to
+// `hashes`. Messages are hashed in parallel SIMD lanes where available.
+void sha256_many(const uint8_t* data, size_t len, size_t count, uint8_t* hashes);
+void sha256_double_many(const uint8_t* data, size_t len, size_t count, uint8_t* hashes);
+
+// SHA512 (BIP32 key derivation)
+void sha512(const uint8_t* data, size_t len, uint8_t* hash);
+
+struct Sha512Ctx {
+    uint64_t state[8];
+    uint8_t buffer[128];
+    uint64_t length; // bytes consumed so far
+
+    Sha512Ctx() { init(); }
+
+    void init();
+    void update(const uint8_t* data, size_t len);
+    void final(uint8_t* hash); // writes 64 bytes; call init() to reuse
+};
+
+// HMAC-SHA512 with the key's inner and outer pad blocks absorbed once.
+// Every MAC under the same key (all children of one BIP32 parent) then
+// starts from the saved states and skips those two compressions.
+class HmacSha512 {
+public:
+    HmacSha512(const uint8_t* key, size_t key_len);
+    ~HmacSha512();
+
+    void mac(const uint8_t* data, size_t len, uint8_t* out) const; // writes 64 bytes
+
+private:
+    friend void pbkdf2_hmac_sha512(const uint8_t*, size_t, const uint8_t*, size_t,
+                                   uint32_t, uint8_t*, size_t);
+
+    Sha512Ctx inner_;
+    Sha512Ctx outer_;
+};
+
+void hmac_sha512(const uint8_t* key, size_t key_len,
+                 const uint8_t* data, size_t len, uint8_t* out);
+
+// PBKDF2-HMAC-SHA512 (BIP39 seeds). The password's pad states are computed
+// once; every further iteration is exactly two compressions of one reused
+// block, with nothing allocated or re-padded inside the loop.
+void pbkdf2_hmac_sha512(const uint8_t* password, size_t password_len,
+                        const uint8_t* salt, size_t salt_len,
+                        uint32_t iterations, uint8_t* out, size_t out_len);
+
 // RIPEMD160 hash function (used for address generation)
 void ripemd160(const uint8_t* data, size_t len, uint8_t* hash);
 void ripemd160(const std::vector<uint8_t>& data, uint8_t* hash);
@@ -22,6 +117,10 @@ void ripemd160(const std::vector<uint8_t>& data, uint8_t* hash);
 void hash160(const uint8_t* data, size_t len, uint8_t* hash);
 void hash160(const std::vector<uint8_t>& data, uint8_t* hash);
 
+// Batch Hash160 of `count` inputs of `len` bytes each (e.g. 33-byte
+// compressed pubkeys) stored back to back. Writes count * 20 bytes.
+void hash160_many(const uint8_t* data, size_t len, size_t count, uint8_t* hashes);
+
 } // namespace doge
 
 #endif // DOGE_HASH_H
@@ -0,0 +1,79 @@
+#include "hash_backends.h"
+
+// SHA-256 using the ARMv8 crypto extensions (most arm64 phones, Apple silicon).
+// Built with -march=armv8-a+crypto; only called when cpu_features().arm_sha2 is set.
+
+#if defined(__aarch64__) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define DOGE_HAVE_ARMV8_SHA2 1
+#include <arm_neon.h>
+#endif
+
+namespace doge {
+namespace detail {
+
+#ifdef DOGE_HAVE_ARMV8_SHA2
+
+// Four rounds on message words M, then (for the first 12 quads) extend the
+// schedule in place so M holds the words needed four quads later
+#define ARMV8_ROUNDS4(M, M1, M2, M3, k, schedule) do { \
+    TMP0 = vaddq_u32(M, vld1q_u32(&SHA256_K[k])); \
+    if (schedule) M = vsha256su0q_u32(M, M1); \
+    TMP1 = STATE0; \
+    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0); \
+    STATE1 = vsha256h2q_u32(STATE1, TMP1, TMP0); \
+    if (schedule) M = vsha256su1q_u32(M, M2, M3); \
+} while (0)
+
+static void transform_armv8(uint32_t* state, const uint8_t* blocks, size_t nblocks) {
+    uint32x4_t STATE0 = vld1q_u32(&state[0]);
+    uint32x4_t STATE1 = vld1q_u32(&state[4]);
+    uint32x4_t ABCD_SAVE, EFGH_SAVE, MSG0, MSG1, MSG2, MSG3, TMP0, TMP1;
+
+    for (; nblocks > 0; nblocks--, blocks += 64) {
+        ABCD_SAVE = STATE0;
+        EFGH_SAVE = STATE1;
+
+        MSG0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 0)));
+        MSG1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 16)));
+        MSG2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 32)));
+        MSG3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 48)));
+
+        ARMV8_ROUNDS4(MSG0, MSG1, MSG2, MSG3, 0, true);
+        ARMV8_ROUNDS4(MSG1, MSG2, MSG3, MSG0, 4, true);
+        ARMV8_ROUNDS4(MSG2, MSG3, MSG0, MSG1, 8, true);
+        ARMV8_ROUNDS4(MSG3, MSG0, MSG1, MSG2, 12, true);
+        ARMV8_ROUNDS4(MSG0, MSG1, MSG2, MSG3, 16, true);
+        ARMV8_ROUNDS4(MSG1, MSG2, MSG3, MSG0, 20, true);
+        ARMV8_ROUNDS4(MSG2, MSG3, MSG0, MSG1, 24, true);
+        ARMV8_ROUNDS4(MSG3, MSG0, MSG1, MSG2, 28, true);
+        ARMV8_ROUNDS4(MSG0, MSG1, MSG2, MSG3, 32, true);
+        ARMV8_ROUNDS4(MSG1, MSG2, MSG3, MSG0, 36, true);
+        ARMV8_ROUNDS4(MSG2, MSG3, MSG0, MSG1, 40, true);
+        ARMV8_ROUNDS4(MSG3, MSG0, MSG1, MSG2, 44, true);
+        ARMV8_ROUNDS4(MSG0, MSG1, MSG2, MSG3, 48, false);
+        ARMV8_ROUNDS4(MSG1, MSG2, MSG3, MSG0, 52, false);
+        ARMV8_ROUNDS4(MSG2, MSG3, MSG0, MSG1, 56, false);
+        ARMV8_ROUNDS4(MSG3, MSG0, MSG1, MSG2, 60, false);
+
+        STATE0 = vaddq_u32(STATE0, ABCD_SAVE);
+        STATE1 = vaddq_u32(STATE1, EFGH_SAVE);
+    }
+
+    vst1q_u32(&state[0], STATE0);
+    vst1q_u32(&state[4], STATE1);
+}
+
+Sha256TransformFn sha256_transform_armv8() {
+    return transform_armv8;
+}
+
+#else
+
+Sha256TransformFn sha256_transform_armv8() {
+    return nullptr;
+}
+
+#endif
+
+} // namespace detail
+} // namespace doge
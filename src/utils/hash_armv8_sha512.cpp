@@ -0,0 +1,120 @@
+#include "hash_backends.h"
+
+// SHA-512 using the ARMv8.2 SHA-512 instructions (Cortex-A76 and later,
+// Apple A13 and later). Built with -march=armv8.2-a+sha3; only called when
+// cpu_features().arm_sha512 is set.
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_SHA512)
+#define DOGE_HAVE_ARMV8_SHA512 1
+#include <arm_neon.h>
+#endif
+
+namespace doge {
+namespace detail {
+
+#ifdef DOGE_HAVE_ARMV8_SHA512
+
+// Two rounds. The working state lives in five registers of two words each
+// (ab, cd, ef, gh and a spare) whose roles rotate every call, so no moves
+// are needed between rounds. With schedule set, the message pair in0 is
+// also advanced to the words needed eight calls later.
+#define ARMV8_DROUND(i0, i1, i2, i3, i4, k, in0, in1, in2, in3, in4, schedule) do { \
+    uint64x2_t KW = vaddq_u64(vld1q_u64(&SHA512_K[k]), in0); \
+    uint64x2_t FG = vextq_u64(i2, i3, 1); \
+    uint64x2_t DE = vextq_u64(i1, i2, 1); \
+    KW = vextq_u64(KW, KW, 1); \
+    i3 = vaddq_u64(i3, KW); \
+    uint64x2_t W9 = vextq_u64(in3, in4, 1); \
+    if (schedule) in0 = vsha512su0q_u64(in0, in1); \
+    i3 = vsha512hq_u64(i3, FG, DE); \
+    if (schedule) in0 = vsha512su1q_u64(in0, in2, W9); \
+    i4 = vaddq_u64(i1, i3); \
+    i3 = vsha512h2q_u64(i3, i1, i0); \
+} while (0)
+
+static void transform_armv8(uint64_t* state, const uint8_t* blocks, size_t nblocks) {
+    uint64x2_t AB = vld1q_u64(&state[0]);
+    uint64x2_t CD = vld1q_u64(&state[2]);
+    uint64x2_t EF = vld1q_u64(&state[4]);
+    uint64x2_t GH = vld1q_u64(&state[6]);
+
+    for (; nblocks > 0; nblocks--, blocks += 128) {
+        uint64x2_t M0 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(blocks + 0)));
+        uint64x2_t M1 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(blocks + 16)));
+        uint64x2_t M2 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(blocks + 32)));
+        uint64x2_t M3 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(blocks + 48)));
+        uint64x2_t M4 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(blocks + 64)));
+        uint64x2_t M5 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(blocks + 80)));
+        uint64x2_t M6 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(blocks + 96)));
+        uint64x2_t M7 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(blocks + 112)));
+
+        uint64x2_t S0 = AB, S1 = CD, S2 = EF, S3 = GH, S4;
+
+        ARMV8_DROUND(S0, S1, S2, S3, S4, 0, M0, M1, M7, M4, M5, true);
+        ARMV8_DROUND(S3, S0, S4, S2, S1, 2, M1, M2, M0, M5, M6, true);
+        ARMV8_DROUND(S2, S3, S1, S4, S0, 4, M2, M3, M1, M6, M7, true);
+        ARMV8_DROUND(S4, S2, S0, S1, S3, 6, M3, M4, M2, M7, M0, true);
+        ARMV8_DROUND(S1, S4, S3, S0, S2, 8, M4, M5, M3, M0, M1, true);
+        ARMV8_DROUND(S0, S1, S2, S3, S4, 10, M5, M6, M4, M1, M2, true);
+        ARMV8_DROUND(S3, S0, S4, S2, S1, 12, M6, M7, M5, M2, M3, true);
+        ARMV8_DROUND(S2, S3, S1, S4, S0, 14, M7, M0, M6, M3, M4, true);
+        ARMV8_DROUND(S4, S2, S0, S1, S3, 16, M0, M1, M7, M4, M5, true);
+        ARMV8_DROUND(S1, S4, S3, S0, S2, 18, M1, M2, M0, M5, M6, true);
+        ARMV8_DROUND(S0, S1, S2, S3, S4, 20, M2, M3, M1, M6, M7, true);
+        ARMV8_DROUND(S3, S0, S4, S2, S1, 22, M3, M4, M2, M7, M0, true);
+        ARMV8_DROUND(S2, S3, S1, S4, S0, 24, M4, M5, M3, M0, M1, true);
+        ARMV8_DROUND(S4, S2, S0, S1, S3, 26, M5, M6, M4, M1, M2, true);
+        ARMV8_DROUND(S1, S4, S3, S0, S2, 28, M6, M7, M5, M2, M3, true);
+        ARMV8_DROUND(S0, S1, S2, S3, S4, 30, M7, M0, M6, M3, M4, true);
+        ARMV8_DROUND(S3, S0, S4, S2, S1, 32, M0, M1, M7, M4, M5, true);
+        ARMV8_DROUND(S2, S3, S1, S4, S0, 34, M1, M2, M0, M5, M6, true);
+        ARMV8_DROUND(S4, S2, S0, S1, S3, 36, M2, M3, M1, M6, M7, true);
+        ARMV8_DROUND(S1, S4, S3, S0, S2, 38, M3, M4, M2, M7, M0, true);
+        ARMV8_DROUND(S0, S1, S2, S3, S4, 40, M4, M5, M3, M0, M1, true);
+        ARMV8_DROUND(S3, S0, S4, S2, S1, 42, M5, M6, M4, M1, M2, true);
+        ARMV8_DROUND(S2, S3, S1, S4, S0, 44, M6, M7, M5, M2, M3, true);
+        ARMV8_DROUND(S4, S2, S0, S1, S3, 46, M7, M0, M6, M3, M4, true);
+        ARMV8_DROUND(S1, S4, S3, S0, S2, 48, M0, M1, M7, M4, M5, true);
+        ARMV8_DROUND(S0, S1, S2, S3, S4, 50, M1, M2, M0, M5, M6, true);
+        ARMV8_DROUND(S3, S0, S4, S2, S1, 52, M2, M3, M1, M6, M7, true);
+        ARMV8_DROUND(S2, S3, S1, S4, S0, 54, M3, M4, M2, M7, M0, true);
+        ARMV8_DROUND(S4, S2, S0, S1, S3, 56, M4, M5, M3, M0, M1, true);
+        ARMV8_DROUND(S1, S4, S3, S0, S2, 58, M5, M6, M4, M1, M2, true);
+        ARMV8_DROUND(S0, S1, S2, S3, S4, 60, M6, M7, M5, M2, M3, true);
+        ARMV8_DROUND(S3, S0, S4, S2, S1, 62, M7, M0, M6, M3, M4, true);
+        ARMV8_DROUND(S2, S3, S1, S4, S0, 64, M0, M1, M7, M4, M5, false);
+        ARMV8_DROUND(S4, S2, S0, S1, S3, 66, M1, M2, M0, M5, M6, false);
+        ARMV8_DROUND(S1, S4, S3, S0, S2, 68, M2, M3, M1, M6, M7, false);
+        ARMV8_DROUND(S0, S1, S2, S3, S4, 70, M3, M4, M2, M7, M0, false);
+        ARMV8_DROUND(S3, S0, S4, S2, S1, 72, M4, M5, M3, M0, M1, false);
+        ARMV8_DROUND(S2, S3, S1, S4, S0, 74, M5, M6, M4, M1, M2, false);
+        ARMV8_DROUND(S4, S2, S0, S1, S3, 76, M6, M7, M5, M2, M3, false);
+        ARMV8_DROUND(S1, S4, S3, S0, S2, 78, M7, M0, M6, M3, M4, false);
+
+        // 40 calls is a whole number of rotations, so S0..S3 are ab..gh again
+        AB = vaddq_u64(AB, S0);
+        CD = vaddq_u64(CD, S1);
+        EF = vaddq_u64(EF, S2);
+        GH = vaddq_u64(GH, S3);
+    }
+
+    vst1q_u64(&state[0], AB);
+    vst1q_u64(&state[2], CD);
+    vst1q_u64(&state[4], EF);
+    vst1q_u64(&state[6], GH);
+}
+
+Sha512TransformFn sha512_transform_armv8() {
+    return transform_armv8;
+}
+
+#else
+
+Sha512TransformFn sha512_transform_armv8() {
+    return nullptr;
+}
+
+#endif
+
+} // namespace detail
+} // namespace doge
@@ -0,0 +1,97 @@
+#include "hash_lanes.h"
+#include "scrypt_lanes.h"
+
+// 8-lane multi-buffer hashing and 2-lane scrypt with AVX2 (Haswell, Zen
+// and later).
+// Built with -mavx2; only called when cpu_features().avx2 is set.
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__AVX2__) || defined(_MSC_VER))
+#define DOGE_HAVE_AVX2_LANES 1
+#include <immintrin.h>
+#endif
+
+namespace doge {
+namespace detail {
+
+#ifdef DOGE_HAVE_AVX2_LANES
+
+namespace {
+
+struct Avx2Ops {
+    typedef __m256i V;
+    static const int LANES = 8;
+
+    static V set1(uint32_t x) { return _mm256_set1_epi32(static_cast<int>(x)); }
+    static V load(const uint32_t* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(uint32_t* p, V x) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), x); }
+    static V add(V a, V b) { return _mm256_add_epi32(a, b); }
+    static V and_(V a, V b) { return _mm256_and_si256(a, b); }
+    static V or_(V a, V b) { return _mm256_or_si256(a, b); }
+    static V xor_(V a, V b) { return _mm256_xor_si256(a, b); }
+    static V andnot(V a, V b) { return _mm256_andnot_si256(a, b); } // ~a & b
+    template <int N> static V shr(V x) { return _mm256_srli_epi32(x, N); }
+    template <int N> static V shl(V x) { return _mm256_slli_epi32(x, N); }
+};
+
+void sha256_lanes_avx2_impl(const uint8_t* data, size_t len, uint8_t* hashes, bool double_hash) {
+    sha256_lanes<Avx2Ops>(data, len, hashes, double_hash);
+}
+
+void ripemd160_32_lanes_avx2_impl(const uint8_t* digests, uint8_t* hashes) {
+    ripemd160_32_lanes<Avx2Ops>(digests, hashes);
+}
+
+// Two scrypt blocks, one per 128-bit half. The Salsa20 word rotations stay
+// within each half, so both hashes run on the same instructions; only the
+// ROMix reads differ, and each half is blended in from its own row.
+struct Avx2ScryptOps : Avx2Ops {
+    static const int LANES = 2;
+
+    // Lane i of each half is word (i + N) % 4 of that half
+    template <int N> static V rotate_words(V x) {
+        return _mm256_shuffle_epi32(x, ((N & 3) | (((N + 1) & 3) << 2) | (((N + 2) & 3) << 4) | (((N + 3) & 3) << 6)));
+    }
+    static uint32_t first_word(V x, int lane) {
+        return static_cast<uint32_t>(lane == 0 ? _mm256_extract_epi32(x, 0) : _mm256_extract_epi32(x, 4));
+    }
+    static V load_rows(const V* v, const size_t* j, int k) {
+        return _mm256_blend_epi32(v[j[0] * 8 + k], v[j[1] * 8 + k], 0xf0);
+    }
+};
+
+void scrypt_romix_avx2_impl(uint32_t* blocks, void* scratch) {
+    scrypt_romix<Avx2ScryptOps>(blocks, scratch);
+}
+
+} // namespace
+
+Sha256LanesBackend sha256_lanes_avx2() {
+    return Sha256LanesBackend{sha256_lanes_avx2_impl, Avx2Ops::LANES};
+}
+
+Ripemd160LanesBackend ripemd160_32_lanes_avx2() {
+    return Ripemd160LanesBackend{ripemd160_32_lanes_avx2_impl, Avx2Ops::LANES};
+}
+
+ScryptRomixBackend scrypt_romix_avx2() {
+    return ScryptRomixBackend{scrypt_romix_avx2_impl, Avx2ScryptOps::LANES};
+}
+
+#else
+
+Sha256LanesBackend sha256_lanes_avx2() {
+    return Sha256LanesBackend{nullptr, 0};
+}
+
+Ripemd160LanesBackend ripemd160_32_lanes_avx2() {
+    return Ripemd160LanesBackend{nullptr, 0};
+}
+
+ScryptRomixBackend scrypt_romix_avx2() {
+    return ScryptRomixBackend{nullptr, 0};
+}
+
+#endif
+
+} // namespace detail
+} // namespace doge
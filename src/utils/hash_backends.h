@@ -0,0 +1,73 @@
+#ifndef DOGE_HASH_BACKENDS_H
+#define DOGE_HASH_BACKENDS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Internal interface between hash.cpp and the ISA-specific hash backends.
+// Each backend lives in its own translation unit so SConstruct can enable
+// the required instruction set for that file only.
+
+namespace doge {
+namespace detail {
+
+extern const uint32_t SHA256_K[64];
+
+// Compress nblocks consecutive 64-byte blocks into state
+typedef void (*Sha256TransformFn)(uint32_t* state, const uint8_t* blocks, size_t nblocks);
+
+// Each getter returns nullptr when the backend was not compiled in for
+// this target. Callers must also check cpu_features() before using it.
+Sha256TransformFn sha256_transform_shani(); // x86 SHA extensions
+Sha256TransformFn sha256_transform_armv8(); // ARMv8 crypto extensions
+
+extern const uint64_t SHA512_K[80];
+
+// Compress nblocks consecutive 128-byte blocks into state
+typedef void (*Sha512TransformFn)(uint64_t* state, const uint8_t* blocks, size_t nblocks);
+
+Sha512TransformFn sha512_transform_armv8(); // ARMv8.2 SHA-512 extensions
+
+// Multi-buffer SHA-256: hash `lanes` messages of len bytes stored back to
+// back, writing lanes * 32 bytes. With double_hash set computes SHA256d.
+typedef void (*Sha256LanesFn)(const uint8_t* data, size_t len, uint8_t* hashes, bool double_hash);
+
+struct Sha256LanesBackend {
+    Sha256LanesFn fn;
+    size_t lanes;
+};
+
+Sha256LanesBackend sha256_lanes_sse2(); // 4 lanes, x86-64 baseline
+Sha256LanesBackend sha256_lanes_avx2(); // 8 lanes
+Sha256LanesBackend sha256_lanes_neon(); // 4 lanes, ARM baseline
+
+// Multi-buffer RIPEMD-160 of `lanes` 32-byte inputs (the SHA-256 half of
+// hash160), writing lanes * 20 bytes
+typedef void (*Ripemd160LanesFn)(const uint8_t* digests, uint8_t* hashes);
+
+struct Ripemd160LanesBackend {
+    Ripemd160LanesFn fn;
+    size_t lanes;
+};
+
+Ripemd160LanesBackend ripemd160_32_lanes_sse2();
+Ripemd160LanesBackend ripemd160_32_lanes_avx2();
+Ripemd160LanesBackend ripemd160_32_lanes_neon();
+
+// scrypt ROMix (N = 1024, r = 1) on `lanes` independent 32-word blocks,
+// in place. scratch holds lanes * 128 KiB, 32-byte aligned.
+typedef void (*ScryptRomixFn)(uint32_t* blocks, void* scratch);
+
+struct ScryptRomixBackend {
+    ScryptRomixFn fn;
+    size_t lanes;
+};
+
+ScryptRomixBackend scrypt_romix_sse2(); // 1 lane, x86-64 baseline
+ScryptRomixBackend scrypt_romix_avx2(); // 2 lanes, one per 128-bit half
+ScryptRomixBackend scrypt_romix_neon(); // 1 lane, ARM baseline
+
+} // namespace detail
+} // namespace doge
+
+#endif // DOGE_HASH_BACKENDS_H
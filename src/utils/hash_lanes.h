@@ -0,0 +1,299 @@
+#ifndef DOGE_HASH_LANES_H
+#define DOGE_HASH_LANES_H
+
+#include "hash_backends.h"
+#include <cstring>
+#include <utility>
+
+// Multi-buffer hash kernels written once against a small vector "ops" type
+// (see hash_sse2.cpp, hash_avx2.cpp, hash_neon.cpp). Lane i of every vector
+// belongs to message i, so N independent messages are hashed with the cost
+// of one.
+//
+// Everything here has internal linkage on purpose: this header is included
+// from translation units built with different ISA flags, and a shared inline
+// definition could let the linker pick an AVX2 copy for baseline code.
+
+namespace doge {
+namespace detail {
+namespace {
+
+const uint32_t SHA256_IV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+inline uint32_t load_be32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+inline void store_be32(uint8_t* p, uint32_t v) {
+    p[0] = uint8_t(v >> 24); p[1] = uint8_t(v >> 16); p[2] = uint8_t(v >> 8); p[3] = uint8_t(v);
+}
+
+template <class Ops, int N>
+inline typename Ops::V rotr(typename Ops::V x) {
+    return Ops::or_(Ops::template shr<N>(x), Ops::template shl<32 - N>(x));
+}
+
+// One SHA-256 compression on every lane. w is consumed as the schedule buffer.
+template <class Ops>
+inline void sha256_compress_lanes(typename Ops::V* s, typename Ops::V* w) {
+    typedef typename Ops::V V;
+    V a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+
+    for (int t = 0; t < 64; t++) {
+        V wt;
+        if (t < 16) {
+            wt = w[t];
+        } else {
+            V w2 = w[(t - 2) & 15], w15 = w[(t - 15) & 15];
+            V sig1 = Ops::xor_(Ops::xor_(rotr<Ops, 17>(w2), rotr<Ops, 19>(w2)), Ops::template shr<10>(w2));
+            V sig0 = Ops::xor_(Ops::xor_(rotr<Ops, 7>(w15), rotr<Ops, 18>(w15)), Ops::template shr<3>(w15));
+            wt = Ops::add(Ops::add(sig1, w[(t - 7) & 15]), Ops::add(sig0, w[t & 15]));
+            w[t & 15] = wt;
+        }
+
+        V ep1 = Ops::xor_(Ops::xor_(rotr<Ops, 6>(e), rotr<Ops, 11>(e)), rotr<Ops, 25>(e));
+        V ch = Ops::xor_(Ops::and_(e, f), Ops::andnot(e, g));
+        V t1 = Ops::add(Ops::add(Ops::add(h, ep1), Ops::add(ch, Ops::set1(SHA256_K[t]))), wt);
+        V ep0 = Ops::xor_(Ops::xor_(rotr<Ops, 2>(a), rotr<Ops, 13>(a)), rotr<Ops, 22>(a));
+        V maj = Ops::or_(Ops::and_(a, b), Ops::and_(c, Ops::or_(a, b)));
+        V t2 = Ops::add(ep0, maj);
+
+        h = g; g = f; f = e; e = Ops::add(d, t1);
+        d = c; c = b; b = a; a = Ops::add(t1, t2);
+    }
+
+    s[0] = Ops::add(s[0], a); s[1] = Ops::add(s[1], b);
+    s[2] = Ops::add(s[2], c); s[3] = Ops::add(s[3], d);
+    s[4] = Ops::add(s[4], e); s[5] = Ops::add(s[5], f);
+    s[6] = Ops::add(s[6], g); s[7] = Ops::add(s[7], h);
+}
+
+// Transpose one 64-byte block from each lane into big-endian word vectors
+template <class Ops>
+inline void load_sha256_block_lanes(typename Ops::V* w, const uint8_t* const* blocks) {
+    alignas(32) uint32_t words[16][Ops::LANES];
+    for (int l = 0; l < Ops::LANES; l++) {
+        for (int t = 0; t < 16; t++) {
+            words[t][l] = load_be32(blocks[l] + t * 4);
+        }
+    }
+    for (int t = 0; t < 16; t++) {
+        w[t] = Ops::load(words[t]);
+    }
+}
+
+// SHA-256 (or SHA256d) of Ops::LANES messages of len bytes, stored back to
+// back in data. Writes Ops::LANES * 32 bytes to hashes.
+template <class Ops>
+void sha256_lanes(const uint8_t* data, size_t len, uint8_t* hashes, bool double_hash) {
+    typedef typename Ops::V V;
+    const int L = Ops::LANES;
+    V s[8], w[16];
+    const uint8_t* blocks[L];
+
+    for (int j = 0; j < 8; j++) {
+        s[j] = Ops::set1(SHA256_IV[j]);
+    }
+
+    // Full blocks straight from the input
+    size_t nfull = len / 64;
+    for (size_t b = 0; b < nfull; b++) {
+        for (int l = 0; l < L; l++) {
+            blocks[l] = data + l * len + b * 64;
+        }
+        load_sha256_block_lanes<Ops>(w, blocks);
+        sha256_compress_lanes<Ops>(s, w);
+    }
+
+    // Padding: every lane has the same length, so the tail layout is shared
+    size_t rem = len - nfull * 64;
+    size_t ntail = rem < 56 ? 1 : 2;
+    uint64_t bitlen = static_cast<uint64_t>(len) * 8;
+    uint8_t tail[L][128];
+
+    for (int l = 0; l < L; l++) {
+        memcpy(tail[l], data + l * len + nfull * 64, rem);
+        tail[l][rem] = 0x80;
+        memset(tail[l] + rem + 1, 0, ntail * 64 - rem - 1);
+        for (int j = 0; j < 8; j++) {
+            tail[l][ntail * 64 - 8 + j] = static_cast<uint8_t>(bitlen >> (56 - j * 8));
+        }
+    }
+
+    for (size_t b = 0; b < ntail; b++) {
+        for (int l = 0; l < L; l++) {
+            blocks[l] = tail[l] + b * 64;
+        }
+        load_sha256_block_lanes<Ops>(w, blocks);
+        sha256_compress_lanes<Ops>(s, w);
+    }
+
+    if (double_hash) {
+        // The 32-byte digest is already in word form: feed it back directly
+        // with the constant padding of a 256-bit message
+        for (int j = 0; j < 8; j++) {
+            w[j] = s[j];
+            s[j] = Ops::set1(SHA256_IV[j]);
+        }
+        w[8] = Ops::set1(0x80000000);
+        for (int j = 9; j < 15; j++) {
+            w[j] = Ops::set1(0);
+        }
+        w[15] = Ops::set1(256);
+        sha256_compress_lanes<Ops>(s, w);
+    }
+
+    alignas(32) uint32_t words[8][L];
+    for (int j = 0; j < 8; j++) {
+        Ops::store(words[j], s[j]);
+    }
+    for (int l = 0; l < L; l++) {
+        for (int j = 0; j < 8; j++) {
+            store_be32(hashes + l * 32 + j * 4, words[j][l]);
+        }
+    }
+}
+
+// RIPEMD-160 message word order and rotation amounts, left and right lines
+constexpr int RMD_RL[80] = {
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+     7,  4, 13,  1, 10,  6, 15,  3, 12,  0,  9,  5,  2, 14, 11,  8,
+     3, 10, 14,  4,  9, 15,  8,  1,  2,  7,  0,  6, 13, 11,  5, 12,
+     1,  9, 11, 10,  0,  8, 12,  4, 13,  3,  7, 15, 14,  5,  6,  2,
+     4,  0,  5,  9,  7, 12,  2, 10, 14,  1,  3,  8, 11,  6, 15, 13
+};
+
+constexpr int RMD_SL[80] = {
+    11, 14, 15, 12,  5,  8,  7,  9, 11, 13, 14, 15,  6,  7,  9,  8,
+     7,  6,  8, 13, 11,  9,  7, 15,  7, 12, 15,  9, 11,  7, 13, 12,
+    11, 13,  6,  7, 14,  9, 13, 15, 14,  8, 13,  6,  5, 12,  7,  5,
+    11, 12, 14, 15, 14, 15,  9,  8,  9, 14,  5,  6,  8,  6,  5, 12,
+     9, 15,  5, 11,  6,  8, 13, 12,  5, 12, 13, 14, 11,  8,  5,  6
+};
+
+constexpr int RMD_RR[80] = {
+     5, 14,  7,  0,  9,  2, 11,  4, 13,  6, 15,  8,  1, 10,  3, 12,
+     6, 11,  3,  7,  0, 13,  5, 10, 14, 15,  8, 12,  4,  9,  1,  2,
+    15,  5,  1,  3,  7, 14,  6,  9, 11,  8, 12,  2, 10,  0,  4, 13,
+     8,  6,  4,  1,  3, 11, 15,  0,  5, 12,  2, 13,  9,  7, 10, 14,
+    12, 15, 10,  4,  1,  5,  8,  7,  6,  2, 13, 14,  0,  3,  9, 11
+};
+
+constexpr int RMD_SR[80] = {
+     8,  9,  9, 11, 13, 15, 15,  5,  7,  7,  8, 11, 14, 14, 12,  6,
+     9, 13, 15,  7, 12,  8,  9, 11,  7,  7, 12,  7,  6, 15, 13, 11,
+     9,  7, 15, 11,  8,  6,  6, 14, 12, 13,  5, 14, 13, 13,  7,  5,
+    15,  5,  8, 11, 14, 14,  6, 14,  6,  9, 12,  9, 12,  5, 15,  8,
+     8,  5, 12,  9, 12,  5, 14,  6,  8, 13,  6,  5, 15, 13, 11, 11
+};
+
+constexpr uint32_t RMD_KL[5] = {0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e};
+constexpr uint32_t RMD_KR[5] = {0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000};
+
+inline uint32_t load_le32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+inline void store_le32(uint8_t* p, uint32_t v) {
+    p[0] = uint8_t(v); p[1] = uint8_t(v >> 8); p[2] = uint8_t(v >> 16); p[3] = uint8_t(v >> 24);
+}
+
+template <class Ops, int N>
+inline typename Ops::V rotl(typename Ops::V x) {
+    return Ops::or_(Ops::template shl<N>(x), Ops::template shr<32 - N>(x));
+}
+
+// The five boolean functions, F..J in the order of the left line
+template <class Ops, int FN>
+inline typename Ops::V rmd_f(typename Ops::V x, typename Ops::V y, typename Ops::V z) {
+    typedef typename Ops::V V;
+    const V ones = Ops::set1(0xffffffff);
+    switch (FN) {
+        case 0: return Ops::xor_(Ops::xor_(x, y), z);
+        case 1: return Ops::or_(Ops::and_(x, y), Ops::andnot(x, z));
+        case 2: return Ops::xor_(Ops::or_(x, Ops::xor_(y, ones)), z);
+        case 3: return Ops::or_(Ops::and_(x, z), Ops::andnot(z, y));
+        default: return Ops::xor_(x, Ops::or_(y, Ops::xor_(z, ones)));
+    }
+}
+
+// Step J of one line. The five working variables rotate roles every step,
+// so they live in v[] and each step picks its (a, b, c, d, e) by index.
+template <class Ops, bool RIGHT, int J>
+inline void rmd_step(typename Ops::V* v, const typename Ops::V* x) {
+    constexpr int round = J / 16;
+    constexpr int a = (5 - J % 5) % 5, b = (a + 1) % 5, c = (a + 2) % 5, d = (a + 3) % 5, e = (a + 4) % 5;
+    constexpr int r = RIGHT ? RMD_RR[J] : RMD_RL[J];
+    constexpr int sh = RIGHT ? RMD_SR[J] : RMD_SL[J];
+    constexpr uint32_t k = RIGHT ? RMD_KR[round] : RMD_KL[round];
+
+    typename Ops::V f = rmd_f<Ops, RIGHT ? 4 - round : round>(v[b], v[c], v[d]);
+    v[a] = Ops::add(v[a], Ops::add(f, Ops::add(x[r], Ops::set1(k))));
+    v[a] = Ops::add(rotl<Ops, sh>(v[a]), v[e]);
+    v[c] = rotl<Ops, 10>(v[c]);
+}
+
+template <class Ops, bool RIGHT, int... J>
+inline void rmd_line(typename Ops::V* v, const typename Ops::V* x, std::integer_sequence<int, J...>) {
+    (rmd_step<Ops, RIGHT, J>(v, x), ...);
+}
+
+// RIPEMD-160 of Ops::LANES 32-byte inputs (SHA-256 digests) stored back to
+// back. A 32-byte message is always a single padded block.
+template <class Ops>
+void ripemd160_32_lanes(const uint8_t* digests, uint8_t* hashes) {
+    typedef typename Ops::V V;
+    const int L = Ops::LANES;
+    static const uint32_t IV[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+
+    alignas(32) uint32_t words[8][L];
+    for (int l = 0; l < L; l++) {
+        for (int t = 0; t < 8; t++) {
+            words[t][l] = load_le32(digests + l * 32 + t * 4);
+        }
+    }
+
+    V x[16];
+    for (int t = 0; t < 8; t++) {
+        x[t] = Ops::load(words[t]);
+    }
+    x[8] = Ops::set1(0x80);
+    for (int t = 9; t < 16; t++) {
+        x[t] = Ops::set1(0);
+    }
+    x[14] = Ops::set1(256); // bit length, little-endian
+
+    V left[5], right[5];
+    for (int j = 0; j < 5; j++) {
+        left[j] = right[j] = Ops::set1(IV[j]);
+    }
+
+    rmd_line<Ops, false>(left, x, std::make_integer_sequence<int, 80>());
+    rmd_line<Ops, true>(right, x, std::make_integer_sequence<int, 80>());
+
+    // After 80 steps the roles have rotated back to (a, b, c, d, e)
+    V out[5];
+    out[0] = Ops::add(Ops::set1(IV[1]), Ops::add(left[2], right[3]));
+    out[1] = Ops::add(Ops::set1(IV[2]), Ops::add(left[3], right[4]));
+    out[2] = Ops::add(Ops::set1(IV[3]), Ops::add(left[4], right[0]));
+    out[3] = Ops::add(Ops::set1(IV[4]), Ops::add(left[0], right[1]));
+    out[4] = Ops::add(Ops::set1(IV[0]), Ops::add(left[1], right[2]));
+
+    for (int j = 0; j < 5; j++) {
+        Ops::store(words[j], out[j]);
+    }
+    for (int l = 0; l < L; l++) {
+        for (int j = 0; j < 5; j++) {
+            store_le32(hashes + l * 20 + j * 4, words[j][l]);
+        }
+    }
+}
+
+} // namespace
+} // namespace detail
+} // namespace doge
+
+#endif // DOGE_HASH_LANES_H
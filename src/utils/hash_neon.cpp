@@ -0,0 +1,88 @@
+#include "hash_lanes.h"
+#include "scrypt_lanes.h"
+
+// 4-lane multi-buffer hashing and the scrypt core with NEON, baseline on
+// arm64 and armeabi-v7a.
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DOGE_HAVE_NEON_LANES 1
+#include <arm_neon.h>
+#endif
+
+namespace doge {
+namespace detail {
+
+#ifdef DOGE_HAVE_NEON_LANES
+
+namespace {
+
+struct NeonOps {
+    typedef uint32x4_t V;
+    static const int LANES = 4;
+
+    static V set1(uint32_t x) { return vdupq_n_u32(x); }
+    static V load(const uint32_t* p) { return vld1q_u32(p); }
+    static void store(uint32_t* p, V x) { vst1q_u32(p, x); }
+    static V add(V a, V b) { return vaddq_u32(a, b); }
+    static V and_(V a, V b) { return vandq_u32(a, b); }
+    static V or_(V a, V b) { return vorrq_u32(a, b); }
+    static V xor_(V a, V b) { return veorq_u32(a, b); }
+    static V andnot(V a, V b) { return vbicq_u32(b, a); } // ~a & b
+    template <int N> static V shr(V x) { return vshrq_n_u32(x, N); }
+    template <int N> static V shl(V x) { return vshlq_n_u32(x, N); }
+};
+
+void sha256_lanes_neon_impl(const uint8_t* data, size_t len, uint8_t* hashes, bool double_hash) {
+    sha256_lanes<NeonOps>(data, len, hashes, double_hash);
+}
+
+void ripemd160_32_lanes_neon_impl(const uint8_t* digests, uint8_t* hashes) {
+    ripemd160_32_lanes<NeonOps>(digests, hashes);
+}
+
+// One scrypt block per 128-bit vector
+struct NeonScryptOps : NeonOps {
+    static const int LANES = 1;
+
+    // Lane i of the result is word (i + N) % 4 of x
+    template <int N> static V rotate_words(V x) { return vextq_u32(x, x, N); }
+    static uint32_t first_word(V x, int) { return vgetq_lane_u32(x, 0); }
+    static V load_rows(const V* v, const size_t* j, int k) { return v[j[0] * 8 + k]; }
+};
+
+void scrypt_romix_neon_impl(uint32_t* blocks, void* scratch) {
+    scrypt_romix<NeonScryptOps>(blocks, scratch);
+}
+
+} // namespace
+
+Sha256LanesBackend sha256_lanes_neon() {
+    return Sha256LanesBackend{sha256_lanes_neon_impl, NeonOps::LANES};
+}
+
+Ripemd160LanesBackend ripemd160_32_lanes_neon() {
+    return Ripemd160LanesBackend{ripemd160_32_lanes_neon_impl, NeonOps::LANES};
+}
+
+ScryptRomixBackend scrypt_romix_neon() {
+    return ScryptRomixBackend{scrypt_romix_neon_impl, NeonScryptOps::LANES};
+}
+
+#else
+
+Sha256LanesBackend sha256_lanes_neon() {
+    return Sha256LanesBackend{nullptr, 0};
+}
+
+Ripemd160LanesBackend ripemd160_32_lanes_neon() {
+    return Ripemd160LanesBackend{nullptr, 0};
+}
+
+ScryptRomixBackend scrypt_romix_neon() {
+    return ScryptRomixBackend{nullptr, 0};
+}
+
+#endif
+
+} // namespace detail
+} // namespace doge
@@ -0,0 +1,99 @@
+#include "hash_backends.h"
+
+// SHA-256 using the x86 SHA extensions (Goldmont, Zen, Ice Lake and later).
+// Built with -msse4.1 -msha; only called when cpu_features().sha_ni is set.
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__SHA__) || defined(_MSC_VER))
+#define DOGE_HAVE_SHANI 1
+#include <immintrin.h>
+#endif
+
+namespace doge {
+namespace detail {
+
+#ifdef DOGE_HAVE_SHANI
+
+// Four rounds: the low two message words go through the first rnds2,
+// the high two through the second
+#define SHANI_ROUNDS4(M, k) do { \
+    MSG = _mm_add_epi32(M, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&SHA256_K[k]))); \
+    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG); \
+    MSG = _mm_shuffle_epi32(MSG, 0x0E); \
+    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG); \
+} while (0)
+
+// Message schedule, split the way the msg1/msg2 instructions want it
+#define SHANI_MSG2(Mnext, Mcur, Mprev) do { \
+    TMP = _mm_alignr_epi8(Mcur, Mprev, 4); \
+    Mnext = _mm_add_epi32(Mnext, TMP); \
+    Mnext = _mm_sha256msg2_epu32(Mnext, Mcur); \
+} while (0)
+
+#define SHANI_MSG1(Mprev, Mcur) Mprev = _mm_sha256msg1_epu32(Mprev, Mcur)
+
+static void transform_shani(uint32_t* state, const uint8_t* blocks, size_t nblocks) {
+    const __m128i BSWAP_MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i STATE0, STATE1, MSG, TMP, MSG0, MSG1, MSG2, MSG3, ABEF_SAVE, CDGH_SAVE;
+
+    // Rearrange ABCD/EFGH into the ABEF/CDGH layout used by sha256rnds2
+    TMP = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    STATE1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+    TMP = _mm_shuffle_epi32(TMP, 0xB1);
+    STATE1 = _mm_shuffle_epi32(STATE1, 0x1B);
+    STATE0 = _mm_alignr_epi8(TMP, STATE1, 8);
+    STATE1 = _mm_blend_epi16(STATE1, TMP, 0xF0);
+
+    for (; nblocks > 0; nblocks--, blocks += 64) {
+        ABEF_SAVE = STATE0;
+        CDGH_SAVE = STATE1;
+
+        MSG0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 0)), BSWAP_MASK);
+        MSG1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16)), BSWAP_MASK);
+        MSG2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 32)), BSWAP_MASK);
+        MSG3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 48)), BSWAP_MASK);
+
+        SHANI_ROUNDS4(MSG0, 0);
+        SHANI_ROUNDS4(MSG1, 4);  SHANI_MSG1(MSG0, MSG1);
+        SHANI_ROUNDS4(MSG2, 8);  SHANI_MSG1(MSG1, MSG2);
+        SHANI_ROUNDS4(MSG3, 12); SHANI_MSG2(MSG0, MSG3, MSG2); SHANI_MSG1(MSG2, MSG3);
+        SHANI_ROUNDS4(MSG0, 16); SHANI_MSG2(MSG1, MSG0, MSG3); SHANI_MSG1(MSG3, MSG0);
+        SHANI_ROUNDS4(MSG1, 20); SHANI_MSG2(MSG2, MSG1, MSG0); SHANI_MSG1(MSG0, MSG1);
+        SHANI_ROUNDS4(MSG2, 24); SHANI_MSG2(MSG3, MSG2, MSG1); SHANI_MSG1(MSG1, MSG2);
+        SHANI_ROUNDS4(MSG3, 28); SHANI_MSG2(MSG0, MSG3, MSG2); SHANI_MSG1(MSG2, MSG3);
+        SHANI_ROUNDS4(MSG0, 32); SHANI_MSG2(MSG1, MSG0, MSG3); SHANI_MSG1(MSG3, MSG0);
+        SHANI_ROUNDS4(MSG1, 36); SHANI_MSG2(MSG2, MSG1, MSG0); SHANI_MSG1(MSG0, MSG1);
+        SHANI_ROUNDS4(MSG2, 40); SHANI_MSG2(MSG3, MSG2, MSG1); SHANI_MSG1(MSG1, MSG2);
+        SHANI_ROUNDS4(MSG3, 44); SHANI_MSG2(MSG0, MSG3, MSG2); SHANI_MSG1(MSG2, MSG3);
+        SHANI_ROUNDS4(MSG0, 48); SHANI_MSG2(MSG1, MSG0, MSG3); SHANI_MSG1(MSG3, MSG0);
+        SHANI_ROUNDS4(MSG1, 52); SHANI_MSG2(MSG2, MSG1, MSG0);
+        SHANI_ROUNDS4(MSG2, 56); SHANI_MSG2(MSG3, MSG2, MSG1);
+        SHANI_ROUNDS4(MSG3, 60);
+
+        STATE0 = _mm_add_epi32(STATE0, ABEF_SAVE);
+        STATE1 = _mm_add_epi32(STATE1, CDGH_SAVE);
+    }
+
+    // Back to ABCD/EFGH
+    TMP = _mm_shuffle_epi32(STATE0, 0x1B);
+    STATE1 = _mm_shuffle_epi32(STATE1, 0xB1);
+    STATE0 = _mm_blend_epi16(TMP, STATE1, 0xF0);
+    STATE1 = _mm_alignr_epi8(STATE1, TMP, 8);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), STATE0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), STATE1);
+}
+
+Sha256TransformFn sha256_transform_shani() {
+    return transform_shani;
+}
+
+#else
+
+Sha256TransformFn sha256_transform_shani() {
+    return nullptr;
+}
+
+#endif
+
+} // namespace detail
+} // namespace doge
@@ -0,0 +1,90 @@
+#include "hash_lanes.h"
+#include "scrypt_lanes.h"
+
+// 4-lane multi-buffer hashing and the scrypt core with SSE2, which every
+// x86-64 CPU has.
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define DOGE_HAVE_SSE2_LANES 1
+#include <emmintrin.h>
+#endif
+
+namespace doge {
+namespace detail {
+
+#ifdef DOGE_HAVE_SSE2_LANES
+
+namespace {
+
+struct Sse2Ops {
+    typedef __m128i V;
+    static const int LANES = 4;
+
+    static V set1(uint32_t x) { return _mm_set1_epi32(static_cast<int>(x)); }
+    static V load(const uint32_t* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(uint32_t* p, V x) { _mm_store_si128(reinterpret_cast<__m128i*>(p), x); }
+    static V add(V a, V b) { return _mm_add_epi32(a, b); }
+    static V and_(V a, V b) { return _mm_and_si128(a, b); }
+    static V or_(V a, V b) { return _mm_or_si128(a, b); }
+    static V xor_(V a, V b) { return _mm_xor_si128(a, b); }
+    static V andnot(V a, V b) { return _mm_andnot_si128(a, b); } // ~a & b
+    template <int N> static V shr(V x) { return _mm_srli_epi32(x, N); }
+    template <int N> static V shl(V x) { return _mm_slli_epi32(x, N); }
+};
+
+void sha256_lanes_sse2_impl(const uint8_t* data, size_t len, uint8_t* hashes, bool double_hash) {
+    sha256_lanes<Sse2Ops>(data, len, hashes, double_hash);
+}
+
+void ripemd160_32_lanes_sse2_impl(const uint8_t* digests, uint8_t* hashes) {
+    ripemd160_32_lanes<Sse2Ops>(digests, hashes);
+}
+
+// One scrypt block per 128-bit vector
+struct Sse2ScryptOps : Sse2Ops {
+    static const int LANES = 1;
+
+    // Lane i of the result is word (i + N) % 4 of x
+    template <int N> static V rotate_words(V x) {
+        return _mm_shuffle_epi32(x, ((N & 3) | (((N + 1) & 3) << 2) | (((N + 2) & 3) << 4) | (((N + 3) & 3) << 6)));
+    }
+    static uint32_t first_word(V x, int) { return static_cast<uint32_t>(_mm_cvtsi128_si32(x)); }
+    static V load_rows(const V* v, const size_t* j, int k) { return v[j[0] * 8 + k]; }
+};
+
+void scrypt_romix_sse2_impl(uint32_t* blocks, void* scratch) {
+    scrypt_romix<Sse2ScryptOps>(blocks, scratch);
+}
+
+} // namespace
+
+Sha256LanesBackend sha256_lanes_sse2() {
+    return Sha256LanesBackend{sha256_lanes_sse2_impl, Sse2Ops::LANES};
+}
+
+Ripemd160LanesBackend ripemd160_32_lanes_sse2() {
+    return Ripemd160LanesBackend{ripemd160_32_lanes_sse2_impl, Sse2Ops::LANES};
+}
+
+ScryptRomixBackend scrypt_romix_sse2() {
+    return ScryptRomixBackend{scrypt_romix_sse2_impl, Sse2ScryptOps::LANES};
+}
+
+#else
+
+Sha256LanesBackend sha256_lanes_sse2() {
+    return Sha256LanesBackend{nullptr, 0};
+}
+
+Ripemd160LanesBackend ripemd160_32_lanes_sse2() {
+    return Ripemd160LanesBackend{nullptr, 0};
+}
+
+ScryptRomixBackend scrypt_romix_sse2() {
+    return ScryptRomixBackend{nullptr, 0};
+}
+
+#endif
+
+} // namespace detail
+} // namespace doge
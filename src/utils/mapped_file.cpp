@@ -0,0 +1,184 @@
+#include "mapped_file.h"
+
+#include <cstdio>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <io.h>
+#include <windows.h>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace doge {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+void MappedFile::swap(MappedFile& other) {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(open_, other.open_);
+#ifdef _WIN32
+    std::swap(file_, other.file_);
+    std::swap(mapping_, other.mapping_);
+#endif
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path, bool random_access) {
+    close();
+
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    if (wlen <= 0) {
+        return false;
+    }
+    std::vector<wchar_t> wpath(wlen);
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, wpath.data(), wlen);
+
+    DWORD hint = random_access ? FILE_FLAG_RANDOM_ACCESS : FILE_FLAG_SEQUENTIAL_SCAN;
+    HANDLE file = CreateFileW(wpath.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | hint, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    file_ = file;
+    open_ = true;
+    if (size.QuadPart == 0) {
+        // Empty files cannot be mapped; they are simply zero bytes long
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        close();
+        return false;
+    }
+
+    mapping_ = mapping;
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_) {
+        CloseHandle(static_cast<HANDLE>(mapping_));
+    }
+    if (file_) {
+        CloseHandle(static_cast<HANDLE>(file_));
+    }
+    data_ = nullptr;
+    size_ = 0;
+    mapping_ = nullptr;
+    file_ = nullptr;
+    open_ = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path, bool random_access) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    if (st.st_size > 0) {
+        void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        madvise(addr, static_cast<size_t>(st.st_size), random_access ? MADV_RANDOM : MADV_NORMAL);
+        data_ = static_cast<const uint8_t*>(addr);
+        size_ = static_cast<size_t>(st.st_size);
+    }
+
+    // The mapping keeps the file referenced after the descriptor is closed
+    ::close(fd);
+    open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
+
+#endif
+
+FILE* create_private_file(const std::string& path) {
+#ifdef _WIN32
+    return fopen(path.c_str(), "wb");
+#else
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        return nullptr;
+    }
+    // The mode above only applies to a new file; tighten a leftover one too
+    FILE* f = fchmod(fd, 0600) == 0 ? fdopen(fd, "wb") : nullptr;
+    if (!f) {
+        ::close(fd);
+    }
+    return f;
+#endif
+}
+
+bool sync_and_close(FILE* f) {
+    bool ok = fflush(f) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(f)) == 0;
+#else
+    ok = ok && fsync(fileno(f)) == 0;
+#endif
+    return fclose(f) == 0 && ok;
+}
+
+bool replace_file(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    wchar_t wfrom[MAX_PATH];
+    wchar_t wto[MAX_PATH];
+    if (!MultiByteToWideChar(CP_UTF8, 0, from.c_str(), -1, wfrom, MAX_PATH) ||
+        !MultiByteToWideChar(CP_UTF8, 0, to.c_str(), -1, wto, MAX_PATH)) {
+        return false;
+    }
+    return MoveFileExW(wfrom, wto, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+} // namespace doge
@@ -0,0 +1,57 @@
+#ifndef DOGE_MAPPED_FILE_H
+#define DOGE_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace doge {
+
+// Read-only memory mapping of a whole file. Pages are faulted in by the OS
+// on first touch, so opening costs the same for a 1 KB and a 1 GB file.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map path. random_access tells the OS not to read ahead, which suits
+    // hash tables and record stores that touch scattered pages.
+    bool open(const std::string& path, bool random_access = false);
+    void close();
+
+    // Exchange mappings, e.g. to replace one only after the new one checks out
+    void swap(MappedFile& other);
+
+    bool is_open() const { return open_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+};
+
+// Create or truncate path for binary writing, readable and writable by
+// the owner only on POSIX (0600, whatever the umask). Windows keeps its
+// default ACLs. Returns null on failure.
+FILE* create_private_file(const std::string& path);
+
+// Flush f to stable storage and close it
+bool sync_and_close(FILE* f);
+
+// Atomically replace to with from. Mappings of the old file stay valid on
+// POSIX; Windows refuses while the old file is still mapped.
+bool replace_file(const std::string& from, const std::string& to);
+
+} // namespace doge
+
+#endif // DOGE_MAPPED_FILE_H
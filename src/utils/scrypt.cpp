@@ -0,0 +1,153 @@
+#include "scrypt.h"
+#include "hash.h"
+#include "hash_backends.h"
+#include "cpu_features.h"
+
+#include <cstring>
+#include <memory>
+
+namespace doge {
+
+static const size_t SCRYPT_N = 1024;
+static const size_t SCRYPT_BLOCK_WORDS = 32; // 128 * r bytes
+static const size_t SCRYPT_MAX_LANES = 2;
+
+// Portable fallback used when no vector backend is available
+#define ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+static void salsa20_8_xor(uint32_t* B, const uint32_t* Bx) {
+    uint32_t x[16];
+    for (int i = 0; i < 16; i++) {
+        x[i] = B[i] ^= Bx[i];
+    }
+
+    for (int round = 0; round < 8; round += 2) {
+        // Columns
+        x[4] ^= ROTL(x[0] + x[12], 7);   x[8] ^= ROTL(x[4] + x[0], 9);
+        x[12] ^= ROTL(x[8] + x[4], 13);  x[0] ^= ROTL(x[12] + x[8], 18);
+        x[9] ^= ROTL(x[5] + x[1], 7);    x[13] ^= ROTL(x[9] + x[5], 9);
+        x[1] ^= ROTL(x[13] + x[9], 13);  x[5] ^= ROTL(x[1] + x[13], 18);
+        x[14] ^= ROTL(x[10] + x[6], 7);  x[2] ^= ROTL(x[14] + x[10], 9);
+        x[6] ^= ROTL(x[2] + x[14], 13);  x[10] ^= ROTL(x[6] + x[2], 18);
+        x[3] ^= ROTL(x[15] + x[11], 7);  x[7] ^= ROTL(x[3] + x[15], 9);
+        x[11] ^= ROTL(x[7] + x[3], 13);  x[15] ^= ROTL(x[11] + x[7], 18);
+
+        // Rows
+        x[1] ^= ROTL(x[0] + x[3], 7);    x[2] ^= ROTL(x[1] + x[0], 9);
+        x[3] ^= ROTL(x[2] + x[1], 13);   x[0] ^= ROTL(x[3] + x[2], 18);
+        x[6] ^= ROTL(x[5] + x[4], 7);    x[7] ^= ROTL(x[6] + x[5], 9);
+        x[4] ^= ROTL(x[7] + x[6], 13);   x[5] ^= ROTL(x[4] + x[7], 18);
+        x[11] ^= ROTL(x[10] + x[9], 7);  x[8] ^= ROTL(x[11] + x[10], 9);
+        x[9] ^= ROTL(x[8] + x[11], 13);  x[10] ^= ROTL(x[9] + x[8], 18);
+        x[12] ^= ROTL(x[15] + x[14], 7); x[13] ^= ROTL(x[12] + x[15], 9);
+        x[14] ^= ROTL(x[13] + x[12], 13); x[15] ^= ROTL(x[14] + x[13], 18);
+    }
+
+    for (int i = 0; i < 16; i++) {
+        B[i] += x[i];
+    }
+}
+
+#undef ROTL
+
+static void scrypt_romix_scalar(uint32_t* X, void* scratch) {
+    uint32_t* V = static_cast<uint32_t*>(scratch);
+
+    for (size_t i = 0; i < SCRYPT_N; i++) {
+        memcpy(V + i * SCRYPT_BLOCK_WORDS, X, SCRYPT_BLOCK_WORDS * 4);
+        salsa20_8_xor(X, X + 16);
+        salsa20_8_xor(X + 16, X);
+    }
+    for (size_t i = 0; i < SCRYPT_N; i++) {
+        const uint32_t* row = V + (X[16] & (SCRYPT_N - 1)) * SCRYPT_BLOCK_WORDS;
+        for (size_t k = 0; k < SCRYPT_BLOCK_WORDS; k++) {
+            X[k] ^= row[k];
+        }
+        salsa20_8_xor(X, X + 16);
+        salsa20_8_xor(X + 16, X);
+    }
+}
+
+// 2-lane AVX2 first; otherwise the one-block SSE2 / NEON core, which is
+// baseline wherever it is compiled in
+static detail::ScryptRomixBackend select_scrypt_romix() {
+    if (cpu_features().avx2) {
+        detail::ScryptRomixBackend avx2 = detail::scrypt_romix_avx2();
+        if (avx2.fn) {
+            return avx2;
+        }
+    }
+
+    detail::ScryptRomixBackend sse2 = detail::scrypt_romix_sse2();
+    if (sse2.fn) {
+        return sse2;
+    }
+
+    detail::ScryptRomixBackend neon = detail::scrypt_romix_neon();
+    if (neon.fn) {
+        return neon;
+    }
+
+    return detail::ScryptRomixBackend{scrypt_romix_scalar, 1};
+}
+
+namespace {
+
+// V for every lane of the widest backend: 128 KiB per lane
+struct alignas(64) ScryptScratch {
+    uint32_t words[SCRYPT_MAX_LANES * SCRYPT_N * SCRYPT_BLOCK_WORDS];
+};
+
+} // namespace
+
+static void* scrypt_thread_scratch() {
+    thread_local std::unique_ptr<ScryptScratch> scratch;
+    if (!scratch) {
+        scratch.reset(new ScryptScratch);
+    }
+    return scratch->words;
+}
+
+void scrypt_1024_1_1_many(const uint8_t* data, size_t len, size_t count, uint8_t* hashes) {
+    static const detail::ScryptRomixBackend romix = select_scrypt_romix();
+    void* scratch = scrypt_thread_scratch();
+
+    alignas(32) uint32_t blocks[SCRYPT_MAX_LANES * SCRYPT_BLOCK_WORDS];
+    uint8_t bytes[SCRYPT_BLOCK_WORDS * 4];
+
+    for (size_t i = 0; i < count; i += romix.lanes) {
+        size_t n = count - i < romix.lanes ? count - i : romix.lanes;
+
+        for (size_t lane = 0; lane < romix.lanes; lane++) {
+            // A short final group repeats its last input in the spare lanes
+            const uint8_t* input = data + (i + (lane < n ? lane : n - 1)) * len;
+            pbkdf2_hmac_sha256(input, len, input, len, 1, bytes, sizeof(bytes));
+            uint32_t* block = blocks + lane * SCRYPT_BLOCK_WORDS;
+            for (size_t k = 0; k < SCRYPT_BLOCK_WORDS; k++) {
+                const uint8_t* p = bytes + k * 4;
+                block[k] = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+            }
+        }
+
+        romix.fn(blocks, scratch);
+
+        for (size_t lane = 0; lane < n; lane++) {
+            const uint32_t* block = blocks + lane * SCRYPT_BLOCK_WORDS;
+            for (size_t k = 0; k < SCRYPT_BLOCK_WORDS; k++) {
+                bytes[k * 4] = static_cast<uint8_t>(block[k]);
+                bytes[k * 4 + 1] = static_cast<uint8_t>(block[k] >> 8);
+                bytes[k * 4 + 2] = static_cast<uint8_t>(block[k] >> 16);
+                bytes[k * 4 + 3] = static_cast<uint8_t>(block[k] >> 24);
+            }
+            const uint8_t* input = data + (i + lane) * len;
+            pbkdf2_hmac_sha256(input, len, bytes, sizeof(bytes), 1, hashes + (i + lane) * 32, 32);
+        }
+    }
+}
+
+void scrypt_1024_1_1(const uint8_t* data, size_t len, uint8_t* hash) {
+    scrypt_1024_1_1_many(data, len, 1, hash);
+}
+
+} // namespace doge
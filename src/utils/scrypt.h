@@ -0,0 +1,22 @@
+#ifndef DOGE_SCRYPT_H
+#define DOGE_SCRYPT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace doge {
+
+// scrypt(P = data, S = data, N = 1024, r = 1, p = 1, dkLen = 32), the
+// Dogecoin / Litecoin proof-of-work hash. The 128 KiB scratchpad is
+// allocated once per thread and reused by every later call on it.
+void scrypt_1024_1_1(const uint8_t* data, size_t len, uint8_t* hash);
+
+// Batch form over `count` inputs of `len` bytes each stored back to back
+// (e.g. 80-byte block headers). Writes count * 32 bytes to `hashes`. With
+// AVX2, two inputs share each pass of the Salsa20/8 core. Runs on the
+// calling thread; split large batches across the thread pool.
+void scrypt_1024_1_1_many(const uint8_t* data, size_t len, size_t count, uint8_t* hashes);
+
+} // namespace doge
+
+#endif // DOGE_SCRYPT_H
@@ -0,0 +1,135 @@
+#ifndef DOGE_SCRYPT_LANES_H
+#define DOGE_SCRYPT_LANES_H
+
+#include "hash_lanes.h"
+
+// scrypt ROMix (N = 1024, r = 1) written once against a small vector "ops"
+// type (see hash_sse2.cpp, hash_avx2.cpp, hash_neon.cpp).
+//
+// Each 16-word Salsa20 block is held as four 4-word vectors in diagonal
+// order (vector k holds words 5i mod 16 for i = 4k..4k+3), so the column
+// and row quarter-rounds each become four vector operations and the switch
+// between them is a word rotation within each vector. An ops type whose
+// vector is 2 x 128 bits runs two independent hashes, one per half, with
+// the same instructions.
+//
+// Internal linkage throughout, for the reason given in hash_lanes.h, whose
+// rotl() this reuses.
+
+namespace doge {
+namespace detail {
+namespace {
+
+const size_t SCRYPT_N = 1024;
+
+// B = Salsa20/8(B ^ Bx)
+template <class Ops>
+inline void salsa20_8_xor(typename Ops::V* B, const typename Ops::V* Bx) {
+    typedef typename Ops::V V;
+
+    V X0 = B[0] = Ops::xor_(B[0], Bx[0]);
+    V X1 = B[1] = Ops::xor_(B[1], Bx[1]);
+    V X2 = B[2] = Ops::xor_(B[2], Bx[2]);
+    V X3 = B[3] = Ops::xor_(B[3], Bx[3]);
+
+    for (int round = 0; round < 8; round += 2) {
+        // Columns
+        X1 = Ops::xor_(X1, rotl<Ops, 7>(Ops::add(X0, X3)));
+        X2 = Ops::xor_(X2, rotl<Ops, 9>(Ops::add(X1, X0)));
+        X3 = Ops::xor_(X3, rotl<Ops, 13>(Ops::add(X2, X1)));
+        X0 = Ops::xor_(X0, rotl<Ops, 18>(Ops::add(X3, X2)));
+
+        X1 = Ops::template rotate_words<3>(X1);
+        X2 = Ops::template rotate_words<2>(X2);
+        X3 = Ops::template rotate_words<1>(X3);
+
+        // Rows
+        X3 = Ops::xor_(X3, rotl<Ops, 7>(Ops::add(X0, X1)));
+        X2 = Ops::xor_(X2, rotl<Ops, 9>(Ops::add(X3, X0)));
+        X1 = Ops::xor_(X1, rotl<Ops, 13>(Ops::add(X2, X3)));
+        X0 = Ops::xor_(X0, rotl<Ops, 18>(Ops::add(X1, X2)));
+
+        X1 = Ops::template rotate_words<1>(X1);
+        X2 = Ops::template rotate_words<2>(X2);
+        X3 = Ops::template rotate_words<3>(X3);
+    }
+
+    B[0] = Ops::add(B[0], X0);
+    B[1] = Ops::add(B[1], X1);
+    B[2] = Ops::add(B[2], X2);
+    B[3] = Ops::add(B[3], X3);
+}
+
+// BlockMix with r = 1: B0 = H(B0 ^ B1), then B1 = H(B1 ^ B0)
+template <class Ops>
+inline void scrypt_block_mix(typename Ops::V* X) {
+    salsa20_8_xor<Ops>(X, X + 4);
+    salsa20_8_xor<Ops>(X + 4, X);
+}
+
+// Position within a 16-word block of the word stored at diagonal slot p
+inline size_t scrypt_diagonal(size_t p) {
+    return (p * 5) % 16;
+}
+
+// ROMix over Ops::LANES blocks of 32 little-endian words stored back to
+// back, in place. scratch holds SCRYPT_N * 8 vectors, aligned for Ops::load.
+template <class Ops>
+void scrypt_romix(uint32_t* blocks, void* scratch) {
+    typedef typename Ops::V V;
+    const int LANES = Ops::LANES;
+
+    // Vector k of lane l covers words 4k..4k+3 of the lane's diagonal form
+    alignas(32) uint32_t tmp[8 * 4 * LANES];
+    for (size_t k = 0; k < 8; k++) {
+        for (int lane = 0; lane < LANES; lane++) {
+            for (size_t w = 0; w < 4; w++) {
+                size_t half = k / 4;
+                tmp[(k * LANES + lane) * 4 + w] = blocks[lane * 32 + half * 16 + scrypt_diagonal((k % 4) * 4 + w)];
+            }
+        }
+    }
+
+    V X[8];
+    for (int k = 0; k < 8; k++) {
+        X[k] = Ops::load(tmp + k * 4 * LANES);
+    }
+
+    V* v = static_cast<V*>(scratch);
+    for (size_t i = 0; i < SCRYPT_N; i++) {
+        for (int k = 0; k < 8; k++) {
+            v[i * 8 + k] = X[k];
+        }
+        scrypt_block_mix<Ops>(X);
+    }
+
+    for (size_t i = 0; i < SCRYPT_N; i++) {
+        // Integerify: word 0 of the second Salsa block, which stays in slot 0
+        size_t j[LANES];
+        for (int lane = 0; lane < LANES; lane++) {
+            j[lane] = Ops::first_word(X[4], lane) & (SCRYPT_N - 1);
+        }
+        for (int k = 0; k < 8; k++) {
+            X[k] = Ops::xor_(X[k], Ops::load_rows(v, j, k));
+        }
+        scrypt_block_mix<Ops>(X);
+    }
+
+    for (int k = 0; k < 8; k++) {
+        Ops::store(tmp + k * 4 * LANES, X[k]);
+    }
+    for (size_t k = 0; k < 8; k++) {
+        for (int lane = 0; lane < LANES; lane++) {
+            for (size_t w = 0; w < 4; w++) {
+                size_t half = k / 4;
+                blocks[lane * 32 + half * 16 + scrypt_diagonal((k % 4) * 4 + w)] = tmp[(k * LANES + lane) * 4 + w];
+            }
+        }
+    }
+}
+
+} // namespace
+} // namespace detail
+} // namespace doge
+
+#endif // DOGE_SCRYPT_LANES_H
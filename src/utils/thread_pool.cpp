@@ -0,0 +1,135 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace doge {
+
+ThreadPool::ThreadPool(size_t workers) {
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; i++) {
+        workers_.emplace_back([this] { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (std::thread& t : workers_) {
+        t.join();
+    }
+}
+
+void ThreadPool::worker_loop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return; // Stopping and drained
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    if (workers_.empty()) {
+        task();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+namespace {
+
+// Shared between the caller and its helper tasks. Helpers may start after
+// the caller has returned, so it is reference counted and a helper only
+// touches fn after registering itself under the lock while chunks remain.
+struct ParallelFor {
+    const std::function<void(size_t, size_t)>* fn;
+    size_t count;
+    size_t chunk;
+    std::atomic<size_t> next{0};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t running = 0;
+
+    void run_chunks() {
+        for (;;) {
+            size_t begin = next.fetch_add(chunk);
+            if (begin >= count) {
+                return;
+            }
+            (*fn)(begin, std::min(begin + chunk, count));
+        }
+    }
+};
+
+} // namespace
+
+void ThreadPool::parallel_for(size_t count, size_t min_chunk,
+                              const std::function<void(size_t begin, size_t end)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    // A few chunks per thread evens out uneven chunk costs
+    size_t threads = workers_.size() + 1;
+    size_t chunk = std::max<size_t>(std::max<size_t>(min_chunk, 1), count / (threads * 4));
+    size_t nchunks = (count + chunk - 1) / chunk;
+    if (nchunks == 1 || workers_.empty()) {
+        fn(0, count);
+        return;
+    }
+
+    auto state = std::make_shared<ParallelFor>();
+    state->fn = &fn;
+    state->count = count;
+    state->chunk = chunk;
+
+    size_t helpers = std::min(workers_.size(), nchunks - 1);
+    for (size_t i = 0; i < helpers; i++) {
+        submit([state] {
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->next.load() >= state->count) {
+                    return; // Caller already finished everything
+                }
+                state->running++;
+            }
+            state->run_chunks();
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->running--;
+            }
+            state->cv.notify_all();
+        });
+    }
+
+    state->run_chunks();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->running == 0; });
+}
+
+ThreadPool& thread_pool() {
+    static ThreadPool pool([] {
+        unsigned int n = std::thread::hardware_concurrency();
+        return n > 1 ? static_cast<size_t>(n - 1) : static_cast<size_t>(0);
+    }());
+    return pool;
+}
+
+} // namespace doge
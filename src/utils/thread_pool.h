@@ -0,0 +1,51 @@
+#ifndef DOGE_THREAD_POOL_H
+#define DOGE_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace doge {
+
+// Fixed set of worker threads shared by all batch APIs. Started on first
+// use with one worker per hardware thread, minus the caller's.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Queue a task to run on some worker
+    void submit(std::function<void()> task);
+
+    // Run fn(begin, end) over [0, count) split into chunks of at least
+    // min_chunk items. The calling thread works through chunks too and
+    // returns once every chunk is done, so nested calls from inside a task
+    // cannot deadlock.
+    void parallel_for(size_t count, size_t min_chunk,
+                      const std::function<void(size_t begin, size_t end)>& fn);
+
+    size_t worker_count() const { return workers_.size(); }
+
+private:
+    void worker_loop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
+
+// Process-wide pool
+ThreadPool& thread_pool();
+
+} // namespace doge
+
+#endif // DOGE_THREAD_POOL_H